@@ -1,18 +1,37 @@
 #include "AppController.h"
 #include <QFileDialog>
+#include <QMessageBox>
 
 AppController::AppController(AppModel* model, MainWindow* view, QObject* parent) : QObject(parent), m_model(model), m_view(view)
 {
+    m_sweep = new SweepRunner(model, this);
+
+    m_view->setResultModel(model->resultFile());
+
     // View -> Controller
     connect(view, &MainWindow::startRequested, model, &AppModel::start);
+    connect(view, &MainWindow::stopRequested, model, &AppModel::stopCurrent);
     connect(view, &MainWindow::folderRequested, this, &AppController::onFolderRequested);
     connect(view, &MainWindow::rangeChanged, this, &AppController::onRangeChanged);
+    connect(view, &MainWindow::scriptNameChanged, model, &AppModel::setScriptName);
+    connect(view, &MainWindow::transportChanged, this, &AppController::onTransportChanged);
+    connect(view, &MainWindow::sweepRequested, this, &AppController::onSweepRequested);
+    connect(view, &MainWindow::sweepStopRequested, m_sweep, &SweepRunner::stop);
+    connect(view, &MainWindow::sweepStopRequested, this, &AppController::refreshSweepProgress);
+    connect(view, &MainWindow::sweepExportRequested, this, &AppController::onSweepExportRequested);
+
+    // Sweep -> Controller -> View
+    connect(m_sweep, &SweepRunner::sampleAdded, this, &AppController::onSweepSampleAdded);
+    connect(m_sweep, &SweepRunner::progressChanged, this, &AppController::refreshSweepProgress);
+    connect(m_sweep, &SweepRunner::finished, this, &AppController::refreshSweepProgress);
+    connect(m_sweep, &SweepRunner::failed, this, &AppController::onSweepFailed);
 
     // Model -> Controller -> View
     connect(model, &AppModel::processInfoChanged, this, &AppController::refreshProcessInfo);
     connect(model, &AppModel::telemetryChanged, this, &AppController::refreshTelemetry);
     connect(model, &AppModel::inputsChanged, this, &AppController::refreshInputs);
     connect(model, &AppModel::outputsChanged, this, &AppController::refreshOutputs);
+    connect(model, &AppModel::partialResult, this, &AppController::onPartialResult);
 
     refreshView();
 }
@@ -40,7 +59,11 @@ void AppController::refreshTelemetry()
 {
     m_view->updateTelemetry(
         m_model->elapsedMaster(),
-        m_model->elapsedSlave()
+        m_model->elapsedSlave(),
+        m_model->queueDepth(),
+        m_model->queueCapacity(),
+        m_model->lastQueueWaitMs(),
+        m_model->maxQueueWaitMs()
     );
 }
 
@@ -57,11 +80,16 @@ void AppController::refreshOutputs()
 {
     m_view->updateOutputs(
         m_model->statusCode(),
-        m_model->sumResult(),
-        m_model->fileContent()
+        m_model->sumResult()
     );
 }
 
+void AppController::onPartialResult(quint64 id, qint64 position, qint64 value)
+{
+    Q_UNUSED(id);
+    m_view->updatePartial(position, value);
+}
+
 void AppController::onFolderRequested()
 {
     QString folder = QFileDialog::getExistingDirectory(m_view, "Select folder");
@@ -73,3 +101,52 @@ void AppController::onRangeChanged(int start, int end)
 {
     m_model->setRange(start, end);
 }
+
+void AppController::onTransportChanged(int index)
+{
+    // Même ordre que transportComboBox
+    m_model->setTransport(index == 1 ? AppModel::Transport::UnixSocket : AppModel::Transport::SharedMemory);
+}
+
+void AppController::onSweepRequested(const QString& spec, int repeat)
+{
+    QVector<SweepRunner::Range> ranges;
+    QString error;
+    if (!SweepRunner::parseRanges(spec, ranges, error))
+    {
+        QMessageBox::warning(m_view, "Sweep", error);
+        return;
+    }
+
+    m_view->clearSweep();
+    m_sweep->run(ranges, repeat);
+}
+
+void AppController::onSweepExportRequested()
+{
+    if (m_sweep->samples().isEmpty())
+        return;
+
+    QString path = QFileDialog::getSaveFileName(m_view, "Export sweep", m_model->folder() + "/sweep.csv", "CSV (*.csv)");
+    if (path.isEmpty())
+        return;
+
+    QString error;
+    if (!m_sweep->exportCsv(path, error))
+        QMessageBox::warning(m_view, "Sweep", "Export failed: " + error);
+}
+
+void AppController::onSweepFailed(const QString& error)
+{
+    QMessageBox::warning(m_view, "Sweep", "Sweep aborted: " + error);
+}
+
+void AppController::onSweepSampleAdded(const SweepRunner::Sample& sample)
+{
+    m_view->addSweepPoint(sample.masterMs, sample.slaveMs, sample.throughput);
+}
+
+void AppController::refreshSweepProgress()
+{
+    m_view->updateSweepProgress(m_sweep->doneJobs(), m_sweep->totalJobs(), m_sweep->isRunning());
+}
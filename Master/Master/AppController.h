@@ -3,6 +3,7 @@
 #include <QObject>
 #include "AppModel.h"
 #include "MainWindow.h"
+#include "SweepRunner.h"
 
 class AppController : public QObject
 {
@@ -14,6 +15,13 @@ public:
 private slots:
     void onFolderRequested();
     void onRangeChanged(int start, int end);
+    void onTransportChanged(int index);
+    void onSweepRequested(const QString& spec, int repeat);
+    void onSweepExportRequested();
+    void onSweepFailed(const QString& error);
+    void onSweepSampleAdded(const SweepRunner::Sample& sample);
+    void onPartialResult(quint64 id, qint64 position, qint64 value);
+    void refreshSweepProgress();
 
     void refreshView();
     void refreshProcessInfo();
@@ -24,4 +32,5 @@ private slots:
 private:
     AppModel* m_model;
     MainWindow* m_view;
+    SweepRunner* m_sweep;
 };
@@ -1,41 +1,95 @@
 #include "AppModel.h"
+#include "SlaveSupervisor.h"
+#include "SocketTransport.h"
+#include <QCoreApplication>
 #include <QDir>
 #include <QFile>
-#include <QTextStream>
+#include <QFileInfo>
 
-AppModel::AppModel(QObject* parent) :
+AppModel::AppModel(QObject* parent, bool startServices) :
 	QObject(parent)
 {
 	m_folder = QDir::currentPath() + "/outputs";
+	m_folderUtf8 = m_folder.toUtf8();
 	m_slaveScriptName = "slave.py";
+	m_resultFile = new ResultFileModel(this);
 
 	connect(&m_processScanTimer, &QTimer::timeout, this, &AppModel::scanSlaveProcess);
+	connect(&m_channelOwnerTimer, &QTimer::timeout, this, &AppModel::checkChannelOwners);
 
-	m_processScanTimer.start(1000);
+	if (startServices)
+		this->startServices();
+}
+
+void AppModel::startServices()
+{
+	if (m_servicesStarted)
+		return;
+	m_servicesStarted = true;
 
 	createSharedMemory();
+	createSocketTransports();
+
+	// Slaves lancés et surveillés par le master si le script est trouvé,
+	// sinon on retombe sur la détection d'un slave lancé à la main
+	if (!startSupervisedSlaves())
+		m_processScanTimer.start(1000);
+
+	resumeInFlightRequest();
 }
 
 AppModel::~AppModel()
 {
-#ifdef Q_OS_WIN
-	if (m_pBuf)
+	if (m_workerThread)
 	{
-		UnmapViewOfFile(m_pBuf);
-		m_pBuf = nullptr;
+		m_workerThread->disconnect(this);
+		m_workerThread->requestInterruption();
+		m_workerThread->wait();
+		delete m_workerThread;
+		m_workerThread = nullptr;
 	}
-	if (m_hMapFile)
+
+	// Une requête en cours sera récupérée par le prochain master
+	if (m_supervisor)
 	{
-		CloseHandle(m_hMapFile);
-		m_hMapFile = nullptr;
+		if (m_hasInFlight)
+			m_supervisor->detach();
+		else
+			m_supervisor->stop();
+	}
+
+#ifdef Q_OS_WIN
+	for (int i = 0; i < IPC_CHANNEL_COUNT; ++i)
+	{
+		if (m_pBuf[i])
+		{
+			UnmapViewOfFile(m_pBuf[i]);
+			m_pBuf[i] = nullptr;
+		}
+		if (m_hMapFile[i])
+		{
+			CloseHandle(m_hMapFile[i]);
+			m_hMapFile[i] = nullptr;
+		}
+
+		m_stats[i].attach(nullptr);
+		if (m_pStats[i])
+		{
+			UnmapViewOfFile(m_pStats[i]);
+			m_pStats[i] = nullptr;
+		}
+		if (m_hStatsFile[i])
+		{
+			CloseHandle(m_hStatsFile[i]);
+			m_hStatsFile[i] = nullptr;
+		}
 	}
 #endif
 
-	if (m_workerThread)
+	for (int i = 0; i < IPC_CHANNEL_COUNT; ++i)
 	{
-		m_workerThread->quit();
-		m_workerThread->wait();
-		delete m_workerThread;
+		delete m_sockets[i];
+		m_sockets[i] = nullptr;
 	}
 }
 
@@ -87,12 +141,6 @@ void AppModel::setSumResult(int result)
 	}
 }
 
-void AppModel::setFileContent(const QString& content)
-{
-	m_fileContent = content;
-	emit outputsChanged();
-}
-
 void AppModel::setElapsedMaster(quint64 ms)
 {
 	if (m_elapsedMaster != ms)
@@ -111,9 +159,22 @@ void AppModel::setElapsedSlave(quint64 ms)
 	}
 }
 
+void AppModel::setScriptName(const QString& scriptName)
+{
+	// Pas de signal : la saisie vient de la vue, qui est déjà à jour
+	if (m_slaveScriptName == scriptName)
+		return;
+	m_slaveScriptName = scriptName;
+
+	// Avant startServices() le nom est seulement retenu
+	if (m_servicesStarted)
+		restartSupervisedSlaves();
+}
+
 void AppModel::setFolder(const QString& folder)
 {
 	m_folder = folder;
+	m_folderUtf8 = folder.toUtf8();
 	emit inputsChanged();
 }
 
@@ -138,7 +199,7 @@ void AppModel::scanSlaveProcess()
 
 	QString command =
 		"Get-CimInstance Win32_Process | "
-		"Where-Object {$_.Name -like \"python*\"} | "
+		"Where-Object {$_.Name -like \"python*\" -or $_.Name -like \"NativeSlave*\"} | "
 		"Select-Object ProcessId, Name, CommandLine | "
 		"ConvertTo-Csv -NoTypeInformation";
 
@@ -151,27 +212,11 @@ void AppModel::scanSlaveProcess()
 
 void AppModel::onScanProcessFinished(int exitCode, QProcess::ExitStatus status)
 {
-	QString output = m_scanProcess->readAllStandardOutput();
+	const QByteArray output = m_scanProcess->readAllStandardOutput();
+	const QByteArray scriptName = m_slaveScriptName.toLatin1();
 
-	bool found = false;
 	int pid = -1;
-
-	QStringList lines = output.split('\n');
-
-	for (const QString& line : lines)
-	{
-		if (line.contains("python", Qt::CaseInsensitive) &&
-			line.contains(m_slaveScriptName, Qt::CaseInsensitive))
-		{
-			found = true;
-
-			QString colPid = line.split(',')[0];
-			colPid = colPid.mid(1, colPid.length() - 2);
-			pid = colPid.toInt();
-
-			break;
-		}
-	}
+	const bool found = findSlaveInScan(output, QLatin1StringView(scriptName), pid);
 
 	if (found != m_slaveFound || pid != m_slavePid)
 	{
@@ -179,6 +224,9 @@ void AppModel::onScanProcessFinished(int exitCode, QProcess::ExitStatus status)
 		m_slavePid = pid;
 		m_slaveState = found ? SlaveState::Idle : SlaveState::NotRunning;
 		emit processInfoChanged();  // SAFE: toujours thread UI
+
+		if (found)
+			drainQueue();
 	}
 
 	m_scanProcess->deleteLater();
@@ -189,30 +237,45 @@ bool AppModel::createSharedMemory()
 {
 	static_assert(sizeof(SharedData) == EXPECTED_SHARED_DATA_SIZE);
 
+	bool ok = true;
+	for (int i = 0; i < IPC_CHANNEL_COUNT; ++i)
+		ok = createSharedMemory(i) && ok;
+
+	writeLayoutDescriptor();
+	return ok;
+}
+
+bool AppModel::createSharedMemory(int channel)
+{
 #ifdef Q_OS_WIN
 	// Fermer l'ancienne mémoire si elle existe
-	if (m_pBuf)
+	if (m_pBuf[channel])
 	{
-		UnmapViewOfFile(m_pBuf);
-		m_pBuf = nullptr;
+		UnmapViewOfFile(m_pBuf[channel]);
+		m_pBuf[channel] = nullptr;
 	}
-	if (m_hMapFile)
+	if (m_hMapFile[channel])
 	{
-		CloseHandle(m_hMapFile);
-		m_hMapFile = nullptr;
+		CloseHandle(m_hMapFile[channel]);
+		m_hMapFile[channel] = nullptr;
 	}
 
+	const QString name = "Local\\" + channelName(channel);
+
 	// Créer la mémoire partagée avec l'API Windows native
-	m_hMapFile = CreateFileMappingW(
+	m_hMapFile[channel] = CreateFileMappingW(
 		INVALID_HANDLE_VALUE,    // utiliser le fichier de pagination
 		nullptr,                 // sécurité par défaut
 		PAGE_READWRITE,          // accès lecture/écriture
 		0,                       // taille haute (32 bits hauts)
 		sizeof(SharedData),      // taille basse (32 bits bas)
-		L"Local\\ipc_masterslave_shm"  // nom de l'objet
+		reinterpret_cast<LPCWSTR>(name.utf16())  // nom de l'objet
 	);
 
-	if (m_hMapFile == nullptr)
+	// Le mapping survit tant qu'un slave le garde ouvert
+	const bool alreadyExists = GetLastError() == ERROR_ALREADY_EXISTS;
+
+	if (m_hMapFile[channel] == nullptr)
 	{
 		DWORD error = GetLastError();
 		qDebug() << "CreateFileMapping failed with error:" << error;
@@ -220,62 +283,213 @@ bool AppModel::createSharedMemory()
 	}
 
 	// Mapper la vue
-	m_pBuf = MapViewOfFile(
-		m_hMapFile,              // handle du mapping
+	m_pBuf[channel] = MapViewOfFile(
+		m_hMapFile[channel],     // handle du mapping
 		FILE_MAP_ALL_ACCESS,     // accès lecture/écriture
 		0,                       // offset haute
 		0,                       // offset basse
 		sizeof(SharedData)       // nombre d'octets
 	);
 
-	if (m_pBuf == nullptr)
+	if (m_pBuf[channel] == nullptr)
 	{
 		DWORD error = GetLastError();
 		qDebug() << "MapViewOfFile failed with error:" << error;
-		CloseHandle(m_hMapFile);
-		m_hMapFile = nullptr;
+		CloseHandle(m_hMapFile[channel]);
+		m_hMapFile[channel] = nullptr;
 		return false;
 	}
 
-	// Initialisation
-	SharedData* data = static_cast<SharedData*>(m_pBuf);
-	memset(data, 0, sizeof(SharedData));
-
-	data->magic = 0xDEADBEEF;
-	data->version = 1;
+	m_reattached[channel] = alreadyExists && tryReattachChannel(channel);
+	if (!m_reattached[channel])
+		resetChannel(channel);
 
-	QByteArray folderBytes = m_folder.toUtf8();
-	strncpy_s(data->resultsFolderPath, sizeof(data->resultsFolderPath), folderBytes.constData(), _TRUNCATE);
+	SumChannel(m_pBuf[channel]).setMasterPid(GetCurrentProcessId());
 
-	data->startNumber = m_start;
-	data->endNumber = m_end;
-	data->requestCounter = m_requestCounter;
-	data->responseCounter = m_requestCounter;
-
-	strncpy_s(data->resultFileName, sizeof(data->resultFileName), "", _TRUNCATE);
-
-	data->codeResult = 0;
-	data->sumResult = 0;
-	data->flags = IPCFlags::IDLE;
+	createStatsRegion(channel);
 
 	qDebug() << "---";
-	qDebug() << "Shared memory created with native Windows API";
-	qDebug() << "Name: " << IPC_NAME;
+	qDebug() << (m_reattached[channel] ? "Shared memory reattached" : "Shared memory created with native Windows API");
+	qDebug() << "Name: " << channelName(channel);
 	qDebug() << "Size:" << sizeof(SharedData) << "bytes";
 	qDebug() << "---";
 
 	return true;
 #else
+	Q_UNUSED(channel);
 	qDebug() << "Shared memory only supported on Windows";
 	return false;
 #endif
 }
 
+bool AppModel::createStatsRegion(int channel)
+{
+#ifdef Q_OS_WIN
+	// Mapping séparé : ipc_top s'y attache en lecture seule sans toucher au canal
+	const QString name = "Local\\" + QString::fromStdString(IpcStats::regionName(channelName(channel).toStdString()));
+
+	m_hStatsFile[channel] = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+		0, sizeof(IpcStatsRegion), reinterpret_cast<LPCWSTR>(name.utf16()));
+	const bool alreadyExists = GetLastError() == ERROR_ALREADY_EXISTS;
+
+	if (m_hStatsFile[channel] == nullptr)
+	{
+		qDebug() << "CreateFileMapping (stats) failed with error:" << GetLastError();
+		return false;
+	}
+
+	m_pStats[channel] = static_cast<IpcStatsRegion*>(MapViewOfFile(m_hStatsFile[channel], FILE_MAP_ALL_ACCESS, 0, 0, sizeof(IpcStatsRegion)));
+	if (m_pStats[channel] == nullptr)
+	{
+		qDebug() << "MapViewOfFile (stats) failed with error:" << GetLastError();
+		CloseHandle(m_hStatsFile[channel]);
+		m_hStatsFile[channel] = nullptr;
+		return false;
+	}
+
+	// Les compteurs survivent à un redémarrage du master tant que le slave garde la région ouverte
+	if (!alreadyExists || !IpcStats::isValid(m_pStats[channel]))
+		IpcStats::initialize(m_pStats[channel]);
+
+	m_stats[channel].attach(&m_pStats[channel]->master);
+	m_stats[channel].setPid(GetCurrentProcessId());
+	return true;
+#else
+	Q_UNUSED(channel);
+	return false;
+#endif
+}
+
+void AppModel::createSocketTransports()
+{
+	// Le slave se connecte de lui-même s'il sait parler socket ; sinon le canal
+	// reste utilisable en mémoire partagée
+	for (int i = 0; i < IPC_CHANNEL_COUNT; ++i)
+	{
+		m_sockets[i] = new SocketTransport(channelName(i).toStdString());
+		if (!m_sockets[i]->listen())
+		{
+			delete m_sockets[i];
+			m_sockets[i] = nullptr;
+		}
+	}
+}
+
+void AppModel::resetChannel(int channel)
+{
+#ifdef Q_OS_WIN
+	if (!m_pBuf[channel])
+		return;
+
+	// Initialisation
+	SumChannel ipc(m_pBuf[channel]);
+	ipc.initialize();
+
+	SharedData* data = ipc.segment();
+
+	copyFolderPath(data->request, m_folderUtf8);
+
+	data->request.startNumber = m_start;
+	data->request.endNumber = m_end;
+	data->requestCounter = m_requestCounter;
+	data->responseCounter = m_requestCounter;
+#else
+	Q_UNUSED(channel);
+#endif
+}
+
+bool AppModel::tryReattachChannel(int channel)
+{
+#ifdef Q_OS_WIN
+	// Un segment d'une autre version de layout est écarté par isConsistent (magic + version)
+	SumChannel ipc(m_pBuf[channel]);
+	if (!ipc.isConsistent())
+	{
+		qDebug() << "Existing segment" << channelName(channel) << "is not consistent, resetting it";
+		return false;
+	}
+
+	// Ne jamais réutiliser un compteur déjà vu par un slave
+	m_requestCounter = qMax(m_requestCounter, ipc.requestCounter());
+	return true;
+#else
+	Q_UNUSED(channel);
+	return false;
+#endif
+}
+
+void AppModel::resumeInFlightRequest()
+{
+#ifdef Q_OS_WIN
+	for (int i = 0; i < IPC_CHANNEL_COUNT; ++i)
+	{
+		if (!m_reattached[i])
+			continue;
+
+		SumChannel ipc(m_pBuf[i]);
+		if (ipc.flags() == IPCFlags::IDLE)
+			continue;
+
+		// Requête publiée par le master précédent : on la reprend sans la republier
+		uint32_t requestCounter = 0;
+		ipc.readRequest(m_inFlightRequest, requestCounter);
+
+		m_activeChannel = i;
+		m_requestCounter = requestCounter;
+		m_hasInFlight = true;
+
+		// Son demandeur est mort avec le master précédent : nouvel id, annoncé par requestResumed
+		m_inFlightId = m_nextRequestId++;
+		emit requestResumed(m_inFlightId);
+
+		m_folder = QString::fromUtf8(m_inFlightRequest.resultsFolderPath,
+			qstrnlen(m_inFlightRequest.resultsFolderPath, sizeof(m_inFlightRequest.resultsFolderPath)));
+		m_start = m_inFlightRequest.startNumber;
+		m_end = m_inFlightRequest.endNumber;
+		emit inputsChanged();
+
+		qDebug() << "Resuming in-flight request" << requestCounter << "as request" << m_inFlightId << "on channel" << channelName(i);
+
+		setMasterState(MasterState::WaitingForSlave);
+		launchWorker(true);
+		return;
+	}
+#endif
+}
+
+QString AppModel::channelName(int channel)
+{
+	// Le canal 0 garde le nom historique, attendu par un slave lancé à la main
+	if (channel == 0)
+		return IPC_NAME;
+	return QString(IPC_NAME) + "_" + QString::number(channel);
+}
+
+bool AppModel::writeLayoutDescriptor()
+{
+	// Descripteur lu par slave.py à la place d'offsets codés en dur
+	QFile file(layoutDescriptorPath());
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+	{
+		qDebug() << "Could not write layout descriptor:" << file.fileName();
+		return false;
+	}
+
+	file.write(QByteArray::fromStdString(SumChannel::layoutJson(IPC_NAME)));
+	file.close();
+	return true;
+}
+
+QString AppModel::layoutDescriptorPath()
+{
+	return QDir::tempPath() + "/" + IPC_NAME + ".layout.json";
+}
+
 SharedData* AppModel::lockSharedMemory()
 {
 #ifdef Q_OS_WIN
-	if (m_pBuf)
-		return static_cast<SharedData*>(m_pBuf);
+	if (m_pBuf[m_activeChannel])
+		return static_cast<SharedData*>(m_pBuf[m_activeChannel]);
 #endif
 	return nullptr;
 }
@@ -288,17 +502,103 @@ void AppModel::unlockSharedMemory()
 
 void AppModel::start()
 {
-	if (m_masterState != MasterState::Idle && m_masterState != MasterState::Finished)
+	submit(m_start, m_end);
+}
+
+void AppModel::setQueueCapacity(int capacity)
+{
+	m_queue.setCapacity(capacity);
+	emit telemetryChanged();
+}
+
+void AppModel::setIntegrityChecks(bool enabled)
+{
+	// Pris en compte à la prochaine requête publiée
+	m_integrity = enabled ? IPCIntegrity::CRC32C : IPCIntegrity::NONE;
+}
+
+void AppModel::setCompletionTimeout(int ms)
+{
+	// Pris en compte à la prochaine requête lancée
+	m_completionTimeoutMs = qMax(0, ms);
+}
+
+void AppModel::setTransport(AppModel::Transport transport)
+{
+	m_transport = transport;
+}
+
+void AppModel::setOverflowPolicy(RequestQueue::OverflowPolicy policy)
+{
+	m_queue.setPolicy(policy);
+}
+
+quint64 AppModel::submit(int start, int end, int priority, const QString& folder)
+{
+	QueuedRequest queued;
+	queued.id = m_nextRequestId++;
+	queued.priority = priority;
+
+	if (folder.isEmpty())
+		copyFolderPath(queued.request, m_folderUtf8);
+	else
+		copyFolderPath(queued.request, folder.toUtf8());
+	queued.request.startNumber = start;
+	queued.request.endNumber = end;
+
+	// Bloquer le thread qui vide la file serait un interblocage : refus si elle est pleine
+	const bool onModelThread = QThread::currentThread() == thread();
+
+	queued.enqueued.start();
+
+	QueuedRequest dropped;
+	switch (m_queue.push(queued, &dropped, !onModelThread))
 	{
-		qDebug() << "Cannot start: master not idle";
-		return;
+	case RequestQueue::PushResult::Rejected:
+		qDebug() << "Queue full: request" << queued.id << "rejected";
+		emit requestDropped(queued.id);
+		return 0;
+
+	case RequestQueue::PushResult::QueuedDroppedOldest:
+		qDebug() << "Queue full: request" << dropped.id << "dropped";
+		emit requestDropped(dropped.id);
+		break;
+
+	case RequestQueue::PushResult::Queued:
+		break;
 	}
 
-	if (!m_slaveFound)
-	{
-		qDebug() << "Cannot start: slave not found";
+	// Toujours vidée depuis le thread du modèle
+	QMetaObject::invokeMethod(this, &AppModel::drainQueue, Qt::QueuedConnection);
+	return queued.id;
+}
+
+bool AppModel::cancel(quint64 id)
+{
+	if (!m_queue.remove(id))
+		return false;
+
+	emit requestDropped(id);
+	emit telemetryChanged();
+	return true;
+}
+
+void AppModel::drainQueue()
+{
+	emit telemetryChanged();
+
+	if (m_hasInFlight || !m_slaveFound)
 		return;
-	}
+
+	// Slave tué sur timeout : la requête suivante attend un slave vivant sur un canal remis à zéro
+	if (m_killPending[m_activeChannel])
+		return;
+
+	QueuedRequest next;
+	if (!m_queue.pop(next))
+		return;
+
+	setQueueWait(next.enqueued.elapsed());
 
 	if (m_workerThread)
 	{
@@ -312,17 +612,109 @@ void AppModel::start()
 
 	m_requestCounter++;
 
-	m_workerThread = new WorkerThread(m_pBuf, m_start, m_end, m_folder, m_requestCounter, this);
+	m_inFlightId = next.id;
+	m_inFlightRequest = next.request;
+	m_hasInFlight = true;
+
+	launchWorker();
+}
+
+void AppModel::setQueueWait(quint64 ms)
+{
+	m_lastQueueWaitMs = ms;
+	m_maxQueueWaitMs = qMax(m_maxQueueWaitMs, ms);
+	emit telemetryChanged();
+}
+
+void AppModel::launchWorker(bool resume)
+{
+	m_inFlightChannel = m_activeChannel;
+
+	IpcStatsWriter& stats = m_stats[m_inFlightChannel];
+	stats.setBusy(true);
+	if (!resume)
+	{
+		stats.add(&IpcStatsBlock::requests);
+		stats.add(&IpcStatsBlock::bytesOut, sizeof(SumRequest));
+	}
+
+	// Une requête reprise est déjà dans le segment partagé
+	m_inFlightSocket = nullptr;
+	SocketTransport* socket = m_sockets[m_inFlightChannel];
+	if (m_transport == Transport::UnixSocket && !resume)
+	{
+		if (socket && socket->isConnected())
+			m_inFlightSocket = socket;
+		else
+			qDebug() << "Socket transport: no slave connected on" << channelName(m_inFlightChannel) << ", using shared memory";
+	}
+
+	// Le CRC n'est demandé qu'à un slave qui l'a annoncé : un slave.py sans descripteur
+	// n'écrit jamais responseCrc et verrait toutes ses réponses rejetées
+	SharedData* segment = lockSharedMemory();
+	void* announced = m_inFlightSocket ? m_inFlightSocket->mirror() : segment;
+	const uint32_t integrity = announced ? SumChannel(announced).negotiatedIntegrity(m_integrity) : IPCIntegrity::NONE;
+	if (integrity != m_negotiatedIntegrity[m_inFlightChannel])
+	{
+		if (integrity != m_integrity)
+			qDebug() << "Master: slave on" << channelName(m_inFlightChannel) << "does not announce CRC32C, integrity checks disabled";
+		m_negotiatedIntegrity[m_inFlightChannel] = integrity;
+	}
+
+	m_workerThread = new WorkerThread(segment, m_inFlightSocket, m_inFlightRequest, m_requestCounter, integrity, resume, this);
+	m_workerThread->setCompletionTimeout(m_completionTimeoutMs);
 
 	connect(m_workerThread, &WorkerThread::finished, this, &AppModel::onWorkerFinished);
 	connect(m_workerThread, &WorkerThread::slaveStateChanged, this, &AppModel::onWorkerSlaveStateChanged);
+	connect(m_workerThread, &WorkerThread::partialResult, this, &AppModel::onWorkerPartialResult);
 	connect(m_workerThread, &QThread::finished, m_workerThread, &QObject::deleteLater);
 
 	m_workerThread->start();
 }
 
+void AppModel::abortWorker()
+{
+	if (!m_workerThread)
+		return;
+
+	// Le résultat de ce worker ne nous intéresse plus
+	m_workerThread->disconnect(this);
+	m_workerThread->requestInterruption();
+	m_workerThread->wait();
+	m_workerThread = nullptr;   // deleteLater déjà connecté sur QThread::finished
+
+	m_stats[m_inFlightChannel].setBusy(false);
+}
+
 void AppModel::onWorkerFinished(int errorCode, quint32 responseCounter, int result, const QString& filename, quint64 masterElapsed)
 {
+	// Requête rejetée par le slave ou réponse rejetée par le master
+	if (errorCode == IPCErrorCode::INTEGRITY_ERROR)
+		m_integrityFailures++;
+
+	IpcStatsWriter& stats = m_stats[m_inFlightChannel];
+	stats.setBusy(false);
+	stats.add(&IpcStatsBlock::responses);
+	stats.add(&IpcStatsBlock::bytesIn, sizeof(SumResponse));
+	if (errorCode == IPCErrorCode::TIMEOUT_ERROR)
+	{
+		stats.add(&IpcStatsBlock::timeouts);
+
+		// Slave vivant mais muet : sa mort déclenche la remise à zéro du canal et la relance
+		// (onSupervisedSlaveExited), la file reprend ensuite
+		if (m_supervisor && m_supervisor->kill(m_inFlightChannel))
+			m_killPending[m_inFlightChannel] = true;
+	}
+	if (m_requestCounter != responseCounter)
+	{
+		stats.add(&IpcStatsBlock::counterMismatches);
+		stats.addError(IPCErrorCode::INVALID_RESPONSE_COUNTER);
+	}
+	else
+	{
+		stats.addError(errorCode);
+	}
+
 	if (m_requestCounter == responseCounter)
 	{
 		setStatusCode(errorCode);
@@ -331,29 +723,22 @@ void AppModel::onWorkerFinished(int errorCode, quint32 responseCounter, int resu
 
 		quint64 elapsedTime = 0;
 
-		// Lire le contenu du fichier
+		// Mapper le fichier : les lignes sont indexées en tâche de fond et lues à l'affichage
 		if (errorCode == IPCErrorCode::SUCCESS && !filename.isEmpty())
 		{
-			QString filePath = m_folder + "/" + filename;
-			QFile file(filePath);
-			if (file.open(QIODevice::ReadOnly | QIODevice::Text))
-			{
-				QTextStream in(&file);
-				setFileContent(in.readAll());
-				file.close();
-
+			const char* folder = m_inFlightRequest.resultsFolderPath;
+			QString filePath = QString::fromUtf8(folder, qstrnlen(folder, sizeof(m_inFlightRequest.resultsFolderPath))) + "/" + filename;
+			if (m_resultFile->open(filePath))
 				tryExractSlaveElapsedFromFile(elapsedTime);
-			}
 			else
-			{
-				setFileContent("Error: Could not read file");
-			}
+				m_resultFile->setMessage("Error: Could not read file");
 		}
 		else
 		{
-			setFileContent("");
+			m_resultFile->clear();
 		}
 		setElapsedSlave(elapsedTime);
+		emit outputsChanged();
 	}
 	else
 	{
@@ -361,12 +746,45 @@ void AppModel::onWorkerFinished(int errorCode, quint32 responseCounter, int resu
 		setSumResult(0);
 		setElapsedMaster(0);
 		setElapsedSlave(0);
-		setFileContent("");
+		m_resultFile->clear();
+		emit outputsChanged();
 	}
 
+	m_hasInFlight = false;
 	setMasterState(MasterState::Finished);
 
 	m_workerThread = nullptr;
+
+	emit requestCompleted(m_inFlightId, m_statusCode, m_sumResult, m_elapsedMaster, m_elapsedSlave);
+
+	// Le slave est libre : requête suivante sans attendre un clic
+	drainQueue();
+}
+
+void AppModel::onWorkerPartialResult(qint64 position, qint64 value)
+{
+	emit partialResult(m_inFlightId, position, value);
+}
+
+void AppModel::stopCurrent()
+{
+	if (!m_hasInFlight)
+		return;
+
+	if (m_inFlightSocket)
+	{
+		qDebug() << "Stop requested for request" << m_inFlightId;
+		m_inFlightSocket->requestStop();
+		return;
+	}
+
+#ifdef Q_OS_WIN
+	if (!m_pBuf[m_inFlightChannel])
+		return;
+
+	qDebug() << "Stop requested for request" << m_inFlightId;
+	SumChannel(m_pBuf[m_inFlightChannel]).requestStop();
+#endif
 }
 
 void AppModel::onWorkerSlaveStateChanged(SlaveState state)
@@ -374,45 +792,275 @@ void AppModel::onWorkerSlaveStateChanged(SlaveState state)
 	setSlaveState(state);
 }
 
+bool AppModel::findSlaveInScan(QByteArrayView csv, QLatin1StringView scriptName, int& pidOut)
+{
+	// Le filtre PowerShell ne garde que python / NativeSlave
+	// Lignes de la forme "1234","python.exe","python -u slave.py"
+	qsizetype pos = 0;
+	while (pos < csv.size())
+	{
+		qsizetype end = csv.indexOf('\n', pos);
+		if (end < 0)
+			end = csv.size();
+
+		const QByteArrayView line = csv.sliced(pos, end - pos);
+		if (QLatin1StringView(line.data(), line.size()).contains(scriptName, Qt::CaseInsensitive))
+		{
+			qsizetype comma = line.indexOf(',');
+			QByteArrayView colPid = line.first(comma < 0 ? line.size() : comma);
+			if (colPid.size() >= 2 && colPid.front() == '"' && colPid.back() == '"')
+				colPid = colPid.sliced(1, colPid.size() - 2);
+
+			pidOut = colPid.toInt();
+			return true;
+		}
+
+		pos = end + 1;
+	}
+
+	return false;
+}
+
+void AppModel::copyFolderPath(SumRequest& request, QByteArrayView folderUtf8)
+{
+	const qsizetype length = qMin(folderUtf8.size(), qsizetype(sizeof(request.resultsFolderPath) - 1));
+	memcpy(request.resultsFolderPath, folderUtf8.data(), static_cast<size_t>(length));
+	request.resultsFolderPath[length] = '\0';
+}
+
 bool AppModel::tryExractSlaveElapsedFromFile(quint64& elapsedOut)
 {
-	if (m_fileContent.isEmpty())
+	// La durée est écrite en tête de fichier par le slave : inutile de
+	// parcourir un fichier de plusieurs centaines de Mo sur le thread UI
+	const QByteArray& head = m_resultFile->head();
+	if (head.isEmpty())
 		return false;
 
-	QStringList lines = m_fileContent.split("\n");
-	bool ok = false;
+	return ResultFileModel::extractDuration(head.constData(), head.size(), elapsedOut);
+}
+
+bool AppModel::startSupervisedSlaves()
+{
+	QString program;
+	QStringList arguments;
+	if (!resolveSlaveCommand(program, arguments))
+	{
+		qDebug() << "Slave script not found, waiting for a manually started slave";
+		return false;
+	}
+
+	QStringList channels;
+	QVector<qint64> livePids;
+	for (int i = 0; i < IPC_CHANNEL_COUNT; ++i)
+	{
+		channels << channelName(i);
+
+		// Slave encore attaché à un segment repris : on l'adopte
+		qint64 pid = -1;
+#ifdef Q_OS_WIN
+		if (m_reattached[i])
+			pid = SumChannel(m_pBuf[i]).slavePid();
+#endif
+		livePids << (pid > 0 ? pid : -1);
+	}
 
-	for (const auto& line : lines)
+	m_supervisor = new SlaveSupervisor(this);
+	connect(m_supervisor, &SlaveSupervisor::slaveStarted, this, &AppModel::onSupervisedSlaveStarted);
+	connect(m_supervisor, &SlaveSupervisor::slaveExited, this, &AppModel::onSupervisedSlaveExited);
+	connect(m_supervisor, &SlaveSupervisor::slaveFailed, this, &AppModel::onSupervisedSlaveFailed);
+
+	m_supervisor->start(program, arguments, channels, livePids);
+	refreshSupervisedProcessInfo();
+
+	m_channelOwnerTimer.start(1000);
+	return true;
+}
+
+void AppModel::restartSupervisedSlaves()
+{
+	QString program;
+	QStringList arguments;
+	if (!resolveSlaveCommand(program, arguments))
 	{
-		if (line.startsWith("Duration:"))
+		// Slaves supervisés conservés ; sans supervision, le scan cherche désormais ce nom
+		qDebug() << "Slave" << m_slaveScriptName << "not found, keeping the current slaves";
+		return;
+	}
+
+	qDebug() << "Slave changed to" << m_slaveScriptName << ", restarting supervised slaves";
+
+	// La requête en cours sera rejouée sur le nouveau slave
+	abortWorker();
+
+	if (m_supervisor)
+	{
+		m_supervisor->disconnect(this);
+		delete m_supervisor;    // arrête les slaves de l'ancienne commande
+		m_supervisor = nullptr;
+	}
+	m_processScanTimer.stop();
+	m_channelOwnerTimer.stop();
+
+	// Rien à adopter : les segments repartent de zéro pour les nouveaux slaves
+	for (int i = 0; i < IPC_CHANNEL_COUNT; ++i)
+	{
+		m_reattached[i] = false;
+		m_killPending[i] = false;
+		resetChannel(i);
+	}
+	m_activeChannel = 0;
+
+	startSupervisedSlaves();
+
+	if (m_hasInFlight)
+	{
+		qDebug() << "Re-issuing request" << m_requestCounter << "on the new slave";
+		setMasterState(MasterState::WaitingForSlave);
+		launchWorker();
+	}
+}
+
+bool AppModel::resolveSlaveCommand(QString& program, QStringList& arguments) const
+{
+	const QStringList dirs = {
+		QCoreApplication::applicationDirPath(),
+		QDir::currentPath(),
+		QDir::currentPath() + "/../Slave",
+		QDir::currentPath() + "/../../Slave"
+	};
+
+	for (const QString& dir : dirs)
+	{
+		QFileInfo info(QDir(dir).filePath(m_slaveScriptName));
+		if (!info.exists())
+			continue;
+
+		if (info.suffix().compare("py", Qt::CaseInsensitive) == 0)
 		{
-			QString value = line.right(line.length() - 10);
+			program = "python";
+			arguments = QStringList() << "-u" << info.absoluteFilePath();
+		}
+		else
+		{
+			program = info.absoluteFilePath();
+			arguments.clear();
+		}
+		return true;
+	}
+	return false;
+}
+
+void AppModel::refreshSupervisedProcessInfo()
+{
+	const bool found = m_supervisor->isRunning(m_activeChannel);
+	const int pid = static_cast<int>(m_supervisor->pid(m_activeChannel));
+
+	if (found != m_slaveFound || pid != m_slavePid)
+	{
+		m_slaveFound = found;
+		m_slavePid = pid;
+		if (m_masterState != MasterState::Starting && m_masterState != MasterState::WaitingForSlave)
+			m_slaveState = found ? SlaveState::Idle : SlaveState::NotRunning;
+		emit processInfoChanged();
+
+		if (found)
+			drainQueue();
+	}
+}
+
+void AppModel::onSupervisedSlaveStarted(int slot)
+{
+	Q_UNUSED(slot);
+	refreshSupervisedProcessInfo();
+}
+
+void AppModel::onSupervisedSlaveExited(int slot)
+{
+	m_failoverTimer.start();
 
-			int v = value.toInt(&ok);
-			if (ok)
-				elapsedOut = v;
+	// Le worker lit et écrit encore ce segment : il doit être arrêté avant la remise à zéro
+	const bool active = slot == m_activeChannel;
+	if (active)
+		abortWorker();
+
+	// Le segment du slave mort peut être dans un état intermédiaire
+	resetChannel(slot);
+	m_killPending[slot] = false;
+
+	if (active)
+	{
+		// Bascule sur un standby déjà prêt, sinon on attend la relance du même slot
+		const int standby = m_supervisor->findRunningSlot(slot);
+		if (standby >= 0)
+			m_activeChannel = standby;
+
+		if (m_hasInFlight)
+		{
+			qDebug() << "Failover: re-issuing request" << m_requestCounter << "on channel" << channelName(m_activeChannel);
+			launchWorker();
 		}
+
+		qDebug() << "Failover to channel" << m_activeChannel << "in" << m_failoverTimer.nsecsElapsed() / 1000 << "us";
+	}
+
+	m_supervisor->restart(slot);
+	refreshSupervisedProcessInfo();
+
+	// File suspendue par un timeout : reprise sur le standby, sinon au démarrage du slot relancé
+	drainQueue();
+}
+
+void AppModel::onSupervisedSlaveFailed(int slot)
+{
+	qDebug() << "Slave on channel" << channelName(slot) << "keeps crashing and is no longer restarted";
+	refreshSupervisedProcessInfo();
+
+	// Plus aucun slave pour servir la requête en cours : elle échoue au lieu d'attendre indéfiniment
+	if (slot == m_activeChannel && m_hasInFlight && m_supervisor->findRunningSlot() < 0)
+	{
+		abortWorker();
+		onWorkerFinished(IPCErrorCode::UNKNOWN_ERROR, m_requestCounter, 0, QString(), 0);
 	}
-	return ok;
+}
+
+void AppModel::checkChannelOwners()
+{
+#ifdef Q_OS_WIN
+	// Un slave lancé à la main (slave.py sans --shm sert le canal 0) et le slave supervisé
+	// se disputeraient MASTER_READY : le canal est laissé au premier, le nôtre s'arrête
+	for (int i = 0; i < IPC_CHANNEL_COUNT; ++i)
+	{
+		if (!m_pBuf[i] || (m_hasInFlight && i == m_inFlightChannel))
+			continue;
+
+		// Notre slave peut écrire le pid d'un descendant (py.exe, lanceur de venv) : pas d'égalité stricte
+		const qint64 pid = SumChannel(m_pBuf[i]).slavePid();
+		if (pid > 0 && !m_supervisor->isOwnSlave(i, pid) && m_supervisor->yieldTo(i, pid))
+			refreshSupervisedProcessInfo();
+	}
+#endif
 }
 
 // ============================================================================
 // WorkerThread Implementation
 // ============================================================================
 
-WorkerThread::WorkerThread(LPVOID sharedMemPtr, int start, int end, const QString& folder, uint32_t requestCounter, QObject* parent) :
+WorkerThread::WorkerThread(LPVOID sharedMemPtr, SocketTransport* transport, const SumRequest& request, uint32_t requestCounter, uint32_t integrity, bool resume, QObject* parent) :
 	QThread(parent),
 	m_pSharedMem(sharedMemPtr),
-	m_start(start),
-	m_end(end),
-	m_folder(folder),
-	m_requestCounter(requestCounter)
+	m_transport(transport),
+	m_request(request),
+	m_requestCounter(requestCounter),
+	m_integrity(integrity),
+	m_resume(resume)
 {
 }
 
 void WorkerThread::run()
 {
-	if (!m_pSharedMem)
+	// Avec le socket, SumChannel lit le miroir local tenu à jour par waitStep()
+	void* segment = m_transport ? m_transport->mirror() : m_pSharedMem;
+	if (!segment)
 	{
 		emit finished(IPCErrorCode::UNKNOWN_ERROR, m_requestCounter, 0, "", 0);
 		return;
@@ -421,68 +1069,86 @@ void WorkerThread::run()
 	QElapsedTimer masterTimer;
 	masterTimer.start();
 
-	SharedData* data = static_cast<SharedData*>(m_pSharedMem);
-
-	// Écrire les inputs et effacer les outputs
-	data->startNumber = m_start;
-	data->endNumber = m_end;
-
-	QByteArray folderBytes = m_folder.toUtf8();
-	strncpy_s(data->resultsFolderPath, sizeof(data->resultsFolderPath), folderBytes.constData(), _TRUNCATE);
-
-	data->requestCounter = m_requestCounter;
-
-	// Effacer les outputs
-	data->codeResult = 0;
-	data->sumResult = 0;
-	memset(data->resultFileName, 0, sizeof(data->resultFileName));
+	SumChannel channel(segment);
 
-	// Signaler au slave qu'il peut commencer
-	data->flags = IPCFlags::MASTER_READY;
+	// Écrire les inputs, effacer les outputs et signaler au slave qu'il peut commencer
+	if (m_transport)
+		m_transport->postRequest(m_request, m_requestCounter, m_integrity);
+	else if (!m_resume)
+		channel.postRequest(m_request, m_requestCounter, m_integrity);
 
 	qDebug() << "Master: MASTER_READY flag set, waiting for slave...";
 
 	// Attendre que le slave démarre
-	const int timeout = 30000; // 30 secondes
-	int elapsed = 0;
+	const qint64 timeout = 30000; // 30 secondes
 
-	while (data->flags == IPCFlags::MASTER_READY && elapsed < timeout)
+	while (channel.flags() == IPCFlags::MASTER_READY && masterTimer.elapsed() < timeout)
 	{
-		QThread::msleep(10);
-		elapsed += 10;
+		if (isInterruptionRequested())
+			return;
+
+		waitStep();
 	}
 
-	if (elapsed >= timeout)
+	if (channel.flags() == IPCFlags::MASTER_READY)
 	{
 		qDebug() << "Master: Timeout waiting for slave to start";
-		data->flags = IPCFlags::IDLE;
-		emit finished(IPCErrorCode::UNKNOWN_ERROR, m_requestCounter, 0, "", masterTimer.elapsed());
+		channel.setFlags(IPCFlags::IDLE);
+		emit finished(IPCErrorCode::TIMEOUT_ERROR, m_requestCounter, 0, "", masterTimer.elapsed());
 		return;
 	}
 
 	qDebug() << "Master: Slave started processing";
 	emit slaveStateChanged(AppModel::SlaveState::Processing);
 
-	// Attendre que le slave termine
-	while (data->flags != IPCFlags::SLAVE_FINISHED)
+	// Attendre que le slave termine, en relayant ses résultats partiels
+	// Chaque partiel prouve que le slave avance : le délai repart de zéro
+	QElapsedTimer silenceTimer;
+	silenceTimer.start();
+
+	while (channel.flags() != IPCFlags::SLAVE_FINISHED)
 	{
-		QThread::msleep(10);
+		// Slave perdu : le master rejoue la requête ailleurs
+		if (isInterruptionRequested())
+			return;
+
+		if (drainPartials(channel))
+			silenceTimer.restart();
+
+		if (m_completionTimeoutMs > 0 && silenceTimer.elapsed() >= m_completionTimeoutMs)
+		{
+			qDebug() << "Master: Timeout waiting for slave to finish";
+			channel.setFlags(IPCFlags::IDLE);
+			emit finished(IPCErrorCode::TIMEOUT_ERROR, m_requestCounter, 0, "", masterTimer.elapsed());
+			return;
+		}
+
+		waitStep();
 	}
 
 	qDebug() << "Master: Slave finished";
+	drainPartials(channel);
 
-	// Lire les résultats
-	int errorCode = data->codeResult;
-	int result = data->sumResult;
-	QString filename = QString::fromUtf8(data->resultFileName);
+	// Lire les résultats et le responseCounter
+	SumResponse response;
+	uint32_t responseCounter = 0;
+	const bool intact = channel.readResponse(response, responseCounter);
 
-	// Lire le responseCounter
-	uint32_t responseCounter = data->responseCounter;
+	int errorCode = response.codeResult;
+	if (!intact)
+	{
+		qDebug() << "Master: Response failed integrity check";
+		errorCode = IPCErrorCode::INTEGRITY_ERROR;
+		response.sumResult = 0;
+		response.resultFileName[0] = '\0';
+	}
+	int result = response.sumResult;
+	QString filename = QString::fromUtf8(response.resultFileName, qstrnlen(response.resultFileName, sizeof(response.resultFileName)));
 
 	quint64 masterElapsed = masterTimer.elapsed();
 
 	// Remettre le flag à IDLE
-	data->flags = IPCFlags::IDLE;
+	channel.setFlags(IPCFlags::IDLE);
 
 	qDebug() << "Master: Process complete. Error code:" << errorCode << "Result:" << result << "File:" << filename;
 
@@ -497,3 +1163,27 @@ void WorkerThread::run()
 
 	emit finished(errorCode, responseCounter, result, filename, masterElapsed);
 }
+
+void WorkerThread::waitStep()
+{
+	// Mémoire partagée : interrogation toutes les 10 ms
+	// Socket : réveil dès qu'une trame arrive
+	if (m_transport)
+		m_transport->pump(10);
+	else
+		QThread::msleep(10);
+}
+
+bool WorkerThread::drainPartials(const SumChannel& channel)
+{
+	const uint32_t previous = m_lastPartial;
+	const uint32_t lost = channel.readPartials(m_requestCounter, m_lastPartial, [this](const IpcPartial& partial)
+	{
+		emit partialResult(partial.position, partial.value);
+	});
+
+	if (lost > 0)
+		qDebug() << "Master:" << lost << "partial result(s) overwritten before being read";
+
+	return m_lastPartial != previous;
+}
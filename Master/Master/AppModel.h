@@ -1,6 +1,9 @@
 #pragma once
 
 #include "SharedData.h"
+#include "IpcStats.h"
+#include "RequestQueue.h"
+#include "ResultFileModel.h"
 
 #include <QObject>
 #include <QString>
@@ -9,7 +12,10 @@
 #include <QThread>
 #include <QElapsedTimer>
 
+#include <atomic>
+
 #ifdef Q_OS_WIN
+#include <winsock2.h>   // avant windows.h (IpcSocket.h)
 #include <windows.h>
 #endif
 
@@ -17,7 +23,24 @@
 #define IPC_NAME "ipc_masterslave_shm"
 #endif
 
+// Canal 0 + canaux de secours pour les slaves en standby
+#ifndef IPC_CHANNEL_COUNT
+#define IPC_CHANNEL_COUNT 2
+#endif
+
+// Contrôle CRC32C des messages, demandé par défaut aux slaves qui l'annoncent (cf. IPCIntegrity)
+#ifndef IPC_INTEGRITY_MODE
+#define IPC_INTEGRITY_MODE IPCIntegrity::CRC32C
+#endif
+
+// Silence maximal d'un slave pendant un calcul (ni réponse ni résultat partiel), 0 = illimité
+#ifndef IPC_COMPLETION_TIMEOUT_MS
+#define IPC_COMPLETION_TIMEOUT_MS 60000
+#endif
+
 class WorkerThread;
+class SlaveSupervisor;
+class SocketTransport;
 
 class AppModel : public QObject
 {
@@ -53,6 +76,23 @@ public:
         return "Unknown";
     }
 
+    // Mécanisme qui porte requêtes et réponses, choisi par requête
+    enum class Transport
+    {
+        SharedMemory,   // segment partagé interrogé en boucle
+        UnixSocket      // trames sur socket AF_UNIX, le slave peut dormir entre deux requêtes
+    };
+
+    static QString transportToString(Transport transport)
+    {
+        switch (transport)
+        {
+        case Transport::SharedMemory: return "Shared memory";
+        case Transport::UnixSocket:   return "Unix socket";
+        }
+        return "Unknown";
+    }
+
     static QString slaveStateToString(SlaveState state)
     {
         switch (state)
@@ -67,9 +107,14 @@ public:
     }
 
 public:
-    explicit AppModel(QObject* parent = nullptr);
+    // startServices = false : ni mémoire partagée ni slaves (benchmarks, outils)
+    explicit AppModel(QObject* parent = nullptr, bool startServices = true);
     ~AppModel() override;
 
+    // Crée les canaux et lance les slaves, une seule fois
+    // Appel différé possible pour choisir le slave avant (setScriptName)
+    void startServices();
+
     // getters
     QString scriptName() const { return m_slaveScriptName; }
     bool slaveFound() const { return m_slaveFound; }
@@ -80,7 +125,7 @@ public:
 
     int statusCode() const { return m_statusCode; }
     int sumResult() const { return m_sumResult; }
-    QString fileContent() const { return m_fileContent; }
+    ResultFileModel* resultFile() const { return m_resultFile; }
 
     quint64 elapsedMaster() const { return m_elapsedMaster; }
     quint64 elapsedSlave() const { return m_elapsedSlave; }
@@ -89,14 +134,56 @@ public:
     int startValue() const { return m_start; }
     int endValue() const { return m_end; }
 
+    int queueDepth() const { return m_queue.size(); }
+    int queueCapacity() const { return m_queue.capacity(); }
+    quint64 lastQueueWaitMs() const { return m_lastQueueWaitMs; }
+    quint64 maxQueueWaitMs() const { return m_maxQueueWaitMs; }
+
+    bool integrityChecks() const { return m_integrity != IPCIntegrity::NONE; }
+    quint64 integrityFailures() const { return m_integrityFailures; }
+    void setIntegrityChecks(bool enabled);
+
+    // Au-delà, la requête échoue en TIMEOUT_ERROR et le slave supervisé est relancé
+    int completionTimeoutMs() const { return m_completionTimeoutMs; }
+    void setCompletionTimeout(int ms);
+
+    Transport transport() const { return m_transport; }
+    Transport inFlightTransport() const { return m_inFlightSocket ? Transport::UnixSocket : Transport::SharedMemory; }
+
+    void setQueueCapacity(int capacity);
+    void setOverflowPolicy(RequestQueue::OverflowPolicy policy);
+
+    // Met une requête en file, renvoie son id (0 si refusée)
+    // Appelable depuis n'importe quel thread si folder est fourni
+    // Avec la politique Block, attend une place sauf depuis le thread du modèle (refus)
+    quint64 submit(int start, int end, int priority = 0, const QString& folder = QString());
+
+    // Retire une requête encore en file (requestDropped) ; sans effet sur la requête en cours
+    bool cancel(quint64 id);
+
+    // Fonctions pures du chemin chaud, exposées pour les benchmarks
+
+    // Cherche scriptName dans la sortie CSV du scan PowerShell, sans découper la sortie
+    static bool findSlaveInScan(QByteArrayView csv, QLatin1StringView scriptName, int& pidOut);
+    // Copie un chemin déjà encodé en UTF-8 dans la requête (tronqué, toujours terminé par \0)
+    static void copyFolderPath(SumRequest& request, QByteArrayView folderUtf8);
+
 public slots:
     // setters (utilisés par le controller)
 
+    void setScriptName(const QString& scriptName);
     void setFolder(const QString& folder);
     void setRange(int start, int end);
 
+    // Pris en compte à la prochaine requête ; sans slave connecté au socket du canal,
+    // la requête passe par la mémoire partagée
+    void setTransport(AppModel::Transport transport);
+
     void start();
 
+    // Demande au slave d'arrêter la requête en cours : il répond STOPPED avec son dernier partiel
+    void stopCurrent();
+
 private:
     void setElapsedMaster(quint64 ms);
     void setElapsedSlave(quint64 ms);
@@ -108,18 +195,40 @@ private:
 
     void setStatusCode(int code);
     void setSumResult(int result);
-    void setFileContent(const QString& content);
 
     bool createSharedMemory();
+    bool createSharedMemory(int channel);
+    bool createStatsRegion(int channel);
+    void createSocketTransports();
+    void resetChannel(int channel);
+    bool tryReattachChannel(int channel);
+    void resumeInFlightRequest();
+    static QString channelName(int channel);
     SharedData* lockSharedMemory();
     void unlockSharedMemory();
+    bool writeLayoutDescriptor();
+    static QString layoutDescriptorPath();
     bool tryExractSlaveElapsedFromFile(quint64& elapsedOut);
 
+    bool startSupervisedSlaves();
+    bool resolveSlaveCommand(QString& program, QStringList& arguments) const;
+    void restartSupervisedSlaves();
+    void refreshSupervisedProcessInfo();
+    void launchWorker(bool resume = false);
+    void setQueueWait(quint64 ms);
+    void abortWorker();
+
 private slots:
     void scanSlaveProcess();
     void onScanProcessFinished(int exitCode, QProcess::ExitStatus status);
     void onWorkerFinished(int errorCode, quint32 responseCounter, int result, const QString& filename, quint64 masterElapsed);
     void onWorkerSlaveStateChanged(SlaveState state);
+    void onWorkerPartialResult(qint64 position, qint64 value);
+    void onSupervisedSlaveStarted(int slot);
+    void onSupervisedSlaveExited(int slot);
+    void onSupervisedSlaveFailed(int slot);
+    void checkChannelOwners();
+    void drainQueue();
 
 signals:
     void processInfoChanged();
@@ -127,6 +236,13 @@ signals:
     void inputsChanged();
     void outputsChanged();
 
+    void requestCompleted(quint64 id, int errorCode, int sumResult, quint64 masterElapsed, quint64 slaveElapsed);
+    void requestDropped(quint64 id);
+    // Requête laissée en cours par un master précédent, reprise par startServices() sous un id
+    // jamais renvoyé par submit() ; requestCompleted et partialResult la suivent sous cet id
+    void requestResumed(quint64 id);
+    void partialResult(quint64 id, qint64 position, qint64 value);
+
 private:
     bool m_slaveFound = false;
     int m_slavePid = -1;
@@ -134,7 +250,10 @@ private:
     int m_start = 0;
     int m_end = 100;
 
-    int m_requestCounter = 0;
+    quint32 m_requestCounter = 0;
+    quint32 m_integrity = IPC_INTEGRITY_MODE;     // demandé ; appliqué aux seuls slaves qui l'annoncent
+    int m_completionTimeoutMs = IPC_COMPLETION_TIMEOUT_MS;
+    quint64 m_integrityFailures = 0;
 
     int m_statusCode = 0;
     int m_sumResult = 0;
@@ -143,20 +262,52 @@ private:
     quint64 m_elapsedSlave = 0;
 
     QTimer m_processScanTimer;
+    QTimer m_channelOwnerTimer;     // slaves lancés à la main sur un canal supervisé
 
     MasterState m_masterState = MasterState::Idle;
     SlaveState m_slaveState = SlaveState::NotRunning;
 
     QString m_slaveScriptName;
-    QString m_fileContent;
     QString m_folder;
+    QByteArray m_folderUtf8;    // m_folder encodé une fois pour toutes les requêtes
 
+    ResultFileModel* m_resultFile{ nullptr };
     QProcess* m_scanProcess{ nullptr };
     WorkerThread* m_workerThread{ nullptr };
+    SlaveSupervisor* m_supervisor{ nullptr };
+    bool m_servicesStarted = false;
+
+    RequestQueue m_queue;
+    std::atomic<quint64> m_nextRequestId{ 1 };
+    quint64 m_lastQueueWaitMs = 0;
+    quint64 m_maxQueueWaitMs = 0;
+
+    // Requête en cours, rejouée sur le standby si le slave actif meurt
+    bool m_hasInFlight = false;
+    quint64 m_inFlightId = 0;
+    SumRequest m_inFlightRequest{};
+    QElapsedTimer m_failoverTimer;
+
+    int m_activeChannel = 0;
+    int m_inFlightChannel = 0;
+
+    Transport m_transport = Transport::SharedMemory;
+    SocketTransport* m_sockets[IPC_CHANNEL_COUNT] = {};
+    SocketTransport* m_inFlightSocket{ nullptr };     // nullptr : requête en cours sur la mémoire partagée
+    quint32 m_negotiatedIntegrity[IPC_CHANNEL_COUNT] = {};    // dernier mode publié sur chaque canal
+
+    // Bloc master des statistiques de chaque canal, écrit uniquement depuis le thread du modèle
+    IpcStatsWriter m_stats[IPC_CHANNEL_COUNT];
+
+    // Canaux repris tels quels d'un master précédent (pas de remise à zéro)
+    bool m_reattached[IPC_CHANNEL_COUNT] = {};
+    bool m_killPending[IPC_CHANNEL_COUNT] = {};     // slave tué sur timeout, pas encore sorti : canal inutilisable
 
 #ifdef Q_OS_WIN
-    HANDLE m_hMapFile = nullptr;
-    LPVOID m_pBuf = nullptr;
+    HANDLE m_hMapFile[IPC_CHANNEL_COUNT] = {};
+    LPVOID m_pBuf[IPC_CHANNEL_COUNT] = {};
+    HANDLE m_hStatsFile[IPC_CHANNEL_COUNT] = {};
+    IpcStatsRegion* m_pStats[IPC_CHANNEL_COUNT] = {};
 #endif
 };
 
@@ -166,8 +317,13 @@ class WorkerThread : public QThread
     Q_OBJECT
 
 public:
-    WorkerThread(LPVOID sharedMemPtr, int start, int end,
-        const QString& folder, uint32_t requestCounter, QObject* parent = nullptr);
+    // transport : nullptr pour la mémoire partagée sharedMemPtr, sinon le socket du canal
+    // resume : la requête est déjà publiée (master relancé), on ne fait qu'attendre la réponse
+    WorkerThread(LPVOID sharedMemPtr, SocketTransport* transport, const SumRequest& request, uint32_t requestCounter,
+        uint32_t integrity, bool resume = false, QObject* parent = nullptr);
+
+    // Silence maximal du slave une fois la requête prise, 0 = illimité (à régler avant start())
+    void setCompletionTimeout(int ms) { m_completionTimeoutMs = ms; }
 
 protected:
     void run() override;
@@ -175,11 +331,18 @@ protected:
 signals:
     void finished(int errorCode, uint32_t responseCounter, int result, const QString& filename, quint64 masterElapsed);
     void slaveStateChanged(AppModel::SlaveState state);
+    void partialResult(qint64 position, qint64 value);
 
 private:
+    bool drainPartials(const SumChannel& channel);
+    void waitStep();
+
     LPVOID m_pSharedMem;
-    int m_start;
-    int m_end;
-    QString m_folder;
+    SocketTransport* m_transport;
+    SumRequest m_request;
     uint32_t m_requestCounter;
+    uint32_t m_integrity;
+    bool m_resume;
+    uint32_t m_lastPartial = 0;
+    int m_completionTimeoutMs = 0;
 };
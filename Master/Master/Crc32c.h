@@ -0,0 +1,125 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+// CRC32C (Castagnoli), polynôme réfléchi 0x82F63B78
+// Instruction crc32 de SSE4.2 si le CPU la supporte, table logicielle sinon
+// Les deux implémentations donnent le même résultat : le slave Python
+// (table seule) reste compatible avec un master accéléré
+// Coût par message : NativeSlave --bench-crc (build Release), à mesurer sur la machine
+// cible ; la table est environ dix fois plus lente, les deux restent loin du poll de 10 ms
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define CRC32C_HAS_SSE42_PATH 1
+#include <nmmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define CRC32C_TARGET_SSE42
+#else
+#include <cpuid.h>
+#define CRC32C_TARGET_SSE42 __attribute__((target("sse4.2")))
+#endif
+#endif
+
+namespace Crc32c
+{
+    constexpr uint32_t POLYNOMIAL = 0x82F63B78;
+
+    struct Table
+    {
+        uint32_t entries[256];
+    };
+
+    constexpr Table makeTable()
+    {
+        Table table{};
+        for (uint32_t i = 0; i < 256; ++i)
+        {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; ++bit)
+                crc = (crc & 1) ? (crc >> 1) ^ POLYNOMIAL : crc >> 1;
+            table.entries[i] = crc;
+        }
+        return table;
+    }
+
+    inline constexpr Table TABLE = makeTable();
+
+    // crc : valeur renvoyée par un appel précédent (0 au départ), ce qui permet
+    // de chaîner plusieurs blocs non contigus
+    inline uint32_t updateSoftware(uint32_t crc, const void* data, size_t size)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        crc = ~crc;
+        for (size_t i = 0; i < size; ++i)
+            crc = TABLE.entries[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+        return ~crc;
+    }
+
+#ifdef CRC32C_HAS_SSE42_PATH
+    CRC32C_TARGET_SSE42 inline uint32_t updateHardware(uint32_t crc, const void* data, size_t size)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        uint64_t crc64 = ~crc;
+
+        // 8 octets par instruction, memcpy pour les accès non alignés (segment packé)
+        while (size >= 8)
+        {
+            uint64_t word;
+            memcpy(&word, bytes, 8);
+            crc64 = _mm_crc32_u64(crc64, word);
+            bytes += 8;
+            size -= 8;
+        }
+
+        uint32_t crc32 = static_cast<uint32_t>(crc64);
+        while (size > 0)
+        {
+            crc32 = _mm_crc32_u8(crc32, *bytes);
+            bytes++;
+            size--;
+        }
+
+        return ~crc32;
+    }
+
+    inline bool detectHardware()
+    {
+#ifdef _MSC_VER
+        int info[4] = {};
+        __cpuid(info, 1);
+        return (info[2] & (1 << 20)) != 0;
+#else
+        unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+        if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+            return false;
+        return (ecx & bit_SSE4_2) != 0;
+#endif
+    }
+#endif
+
+    inline bool hasHardware()
+    {
+#ifdef CRC32C_HAS_SSE42_PATH
+        static const bool available = detectHardware();
+        return available;
+#else
+        return false;
+#endif
+    }
+
+    inline uint32_t update(uint32_t crc, const void* data, size_t size)
+    {
+#ifdef CRC32C_HAS_SSE42_PATH
+        if (hasHardware())
+            return updateHardware(crc, data, size);
+#endif
+        return updateSoftware(crc, data, size);
+    }
+
+    inline uint32_t compute(const void* data, size_t size)
+    {
+        return update(0, data, size);
+    }
+}
@@ -0,0 +1,466 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <atomic>
+#include <string>
+#include <type_traits>
+#include "Crc32c.h"
+
+#ifndef IPC_MAGIC
+#define IPC_MAGIC 0xDEADBEEF
+#endif // !IPC_MAGIC
+
+// À incrémenter à chaque changement du layout de IpcSegment
+// 1 : 548 octets, jusqu'aux flags
+// 2 : 556 octets, + masterPid / slavePid
+// 3 : 568 octets, + integrity / requestCrc / responseCrc
+// 4 : 960 octets, + partialHead / control / partials
+// 5 : 964 octets, + slaveIntegrity
+#ifndef IPC_VERSION
+#define IPC_VERSION 5
+#endif // !IPC_VERSION
+
+namespace IPCFlags
+{
+    constexpr uint32_t IDLE = 0x0;           // État initial, au repos
+    constexpr uint32_t MASTER_READY = 0x1;   // Master a écrit les inputs, slave peut commencer
+    constexpr uint32_t SLAVE_STARTED = 0x2;  // Slave a lu les inputs et commence le traitement
+    constexpr uint32_t SLAVE_FINISHED = 0x4; // Slave a terminé et écrit les outputs
+}
+
+// Contrôle d'intégrité des messages, choisi par le master à chaque requête
+// Les modes sont aussi des bits : le slave annonce ceux qu'il sait calculer (slaveIntegrity)
+namespace IPCIntegrity
+{
+    constexpr uint32_t NONE = 0x0;
+    constexpr uint32_t CRC32C = 0x1;    // CRC32C de la requête (+ requestCounter) et de la réponse (+ responseCounter)
+}
+
+// Commandes du master vers le slave pendant un calcul
+namespace IPCControl
+{
+    constexpr uint32_t NONE = 0x0;
+    constexpr uint32_t STOP = 0x1;          // le slave s'arrête au prochain résultat partiel
+}
+
+// Nombre de résultats partiels conservés dans l'anneau du segment
+#ifndef IPC_PARTIAL_RING_SIZE
+#define IPC_PARTIAL_RING_SIZE 16
+#endif // !IPC_PARTIAL_RING_SIZE
+
+#pragma pack(push, 1)
+// Résultat partiel publié par le slave pendant un calcul
+// sequence est écrit en dernier : une entrée en cours d'écriture a sequence == 0
+struct IpcPartial
+{
+    uint32_t sequence;          // 1, 2, 3... depuis le début de la requête
+    uint32_t requestCounter;    // requête à laquelle se rapporte l'entrée
+    int64_t position;           // avancement (sémantique propre au job)
+    int64_t value;              // agrégat partiel
+};
+#pragma pack(pop)
+
+// Type d'un champ, tel qu'exposé dans le descripteur de layout
+enum class IpcFieldType : uint32_t
+{
+    UInt32,
+    Int32,
+    CString
+};
+
+struct IpcField
+{
+    const char* name;
+    uint32_t offset;    // relatif au début du bloc (requête ou réponse)
+    uint32_t size;
+    IpcFieldType type;
+};
+
+// Chaque type de requête / réponse décrit ses champs via une spécialisation :
+//     template<> struct IpcFieldList<MyRequest> { static constexpr IpcField fields[] = { ... }; };
+template<typename T>
+struct IpcFieldList;
+
+#pragma pack(push, 1)
+// Segment générique : en-tête, requête, compteurs, réponse, flags, propriétaires
+// Avec SumRequest / SumResponse on retrouve l'ancien layout à plat jusqu'aux flags
+template<typename Request, typename Response>
+struct IpcSegment
+{
+    uint32_t magic = IPC_MAGIC;
+    uint32_t version = IPC_VERSION;
+
+    Request request;
+
+    uint32_t requestCounter;
+    uint32_t responseCounter;
+
+    Response response;
+
+    uint32_t flags;
+
+    // Propriétaires du segment, pour qu'un master relancé retrouve le slave vivant
+    uint32_t masterPid;
+    uint32_t slavePid;
+
+    // Intégrité : mode demandé par le master et sommes de contrôle
+    uint32_t integrity;
+    uint32_t requestCrc;
+    uint32_t responseCrc;
+
+    // Résultats partiels : anneau écrit par le slave, control écrit par le master
+    uint32_t partialHead;       // séquence de la dernière entrée publiée
+    uint32_t control;
+    IpcPartial partials[IPC_PARTIAL_RING_SIZE];
+
+    // Modes d'intégrité que le slave sait vérifier et produire, annoncés à l'attache
+    // Le master n'en demande pas d'autre : un slave qui n'annonce rien est servi sans contrôle
+    uint32_t slaveIntegrity;
+};
+#pragma pack(pop)
+
+// Canal typé au-dessus d'une zone mappée
+// Les offsets sont calculés à la compilation et vérifiés contre le layout réel
+template<typename Request, typename Response>
+class IpcChannel
+{
+    static_assert(std::is_trivially_copyable<Request>::value, "Request must be trivially copyable");
+    static_assert(std::is_trivially_copyable<Response>::value, "Response must be trivially copyable");
+    static_assert(std::is_standard_layout<Request>::value, "Request must be standard layout");
+    static_assert(std::is_standard_layout<Response>::value, "Response must be standard layout");
+
+public:
+    using Segment = IpcSegment<Request, Response>;
+
+    static constexpr uint32_t kOffsetMagic = 0;
+    static constexpr uint32_t kOffsetVersion = 4;
+    static constexpr uint32_t kOffsetRequest = 8;
+    static constexpr uint32_t kOffsetRequestCounter = kOffsetRequest + sizeof(Request);
+    static constexpr uint32_t kOffsetResponseCounter = kOffsetRequestCounter + 4;
+    static constexpr uint32_t kOffsetResponse = kOffsetResponseCounter + 4;
+    static constexpr uint32_t kOffsetFlags = kOffsetResponse + sizeof(Response);
+    static constexpr uint32_t kOffsetMasterPid = kOffsetFlags + 4;
+    static constexpr uint32_t kOffsetSlavePid = kOffsetMasterPid + 4;
+    static constexpr uint32_t kOffsetIntegrity = kOffsetSlavePid + 4;
+    static constexpr uint32_t kOffsetRequestCrc = kOffsetIntegrity + 4;
+    static constexpr uint32_t kOffsetResponseCrc = kOffsetRequestCrc + 4;
+    static constexpr uint32_t kOffsetPartialHead = kOffsetResponseCrc + 4;
+    static constexpr uint32_t kOffsetControl = kOffsetPartialHead + 4;
+    static constexpr uint32_t kOffsetPartials = kOffsetControl + 4;
+    static constexpr uint32_t kPartialCount = IPC_PARTIAL_RING_SIZE;
+    static constexpr uint32_t kOffsetSlaveIntegrity = kOffsetPartials + kPartialCount * sizeof(IpcPartial);
+    static constexpr uint32_t kSize = kOffsetSlaveIntegrity + 4;
+
+    static_assert(offsetof(Segment, request) == kOffsetRequest, "request offset mismatch");
+    static_assert(offsetof(Segment, requestCounter) == kOffsetRequestCounter, "requestCounter offset mismatch");
+    static_assert(offsetof(Segment, responseCounter) == kOffsetResponseCounter, "responseCounter offset mismatch");
+    static_assert(offsetof(Segment, response) == kOffsetResponse, "response offset mismatch");
+    static_assert(offsetof(Segment, flags) == kOffsetFlags, "flags offset mismatch");
+    static_assert(offsetof(Segment, masterPid) == kOffsetMasterPid, "masterPid offset mismatch");
+    static_assert(offsetof(Segment, slavePid) == kOffsetSlavePid, "slavePid offset mismatch");
+    static_assert(offsetof(Segment, integrity) == kOffsetIntegrity, "integrity offset mismatch");
+    static_assert(offsetof(Segment, requestCrc) == kOffsetRequestCrc, "requestCrc offset mismatch");
+    static_assert(offsetof(Segment, responseCrc) == kOffsetResponseCrc, "responseCrc offset mismatch");
+    static_assert(offsetof(Segment, partialHead) == kOffsetPartialHead, "partialHead offset mismatch");
+    static_assert(offsetof(Segment, control) == kOffsetControl, "control offset mismatch");
+    static_assert(offsetof(Segment, partials) == kOffsetPartials, "partials offset mismatch");
+    static_assert(offsetof(Segment, slaveIntegrity) == kOffsetSlaveIntegrity, "slaveIntegrity offset mismatch");
+    static_assert(sizeof(Segment) == kSize, "segment size mismatch");
+
+    // Les champs de synchro doivent rester alignés pour des accès 32 bits atomiques
+    static_assert(kOffsetRequestCounter % 4 == 0, "requestCounter must be 4-byte aligned");
+    static_assert(kOffsetFlags % 4 == 0, "flags must be 4-byte aligned");
+    static_assert(kOffsetPartials % 8 == 0, "partials must be 8-byte aligned");
+
+public:
+    explicit IpcChannel(void* mapping = nullptr) :
+        m_segment(static_cast<Segment*>(mapping))
+    {
+    }
+
+    Segment* segment() const { return m_segment; }
+    bool isMapped() const { return m_segment != nullptr; }
+    // Un segment d'une autre version n'a pas ce layout : on ne le sert pas
+    bool isValid() const
+    {
+        return m_segment && load(&m_segment->magic) == IPC_MAGIC && load(&m_segment->version) == IPC_VERSION;
+    }
+
+    // Remise à zéro complète du segment (côté master uniquement)
+    void initialize()
+    {
+        memset(static_cast<void*>(m_segment), 0, kSize);
+        m_segment->magic = IPC_MAGIC;
+        m_segment->version = IPC_VERSION;
+        store(&m_segment->flags, IPCFlags::IDLE);
+    }
+
+    uint32_t flags() const { return load(&m_segment->flags); }
+    void setFlags(uint32_t flags) { store(&m_segment->flags, flags); }
+
+    uint32_t requestCounter() const { return load(&m_segment->requestCounter); }
+    uint32_t responseCounter() const { return load(&m_segment->responseCounter); }
+
+    uint32_t masterPid() const { return load(&m_segment->masterPid); }
+    void setMasterPid(uint32_t pid) { store(&m_segment->masterPid, pid); }
+    uint32_t slavePid() const { return load(&m_segment->slavePid); }
+    void setSlavePid(uint32_t pid) { store(&m_segment->slavePid, pid); }
+
+    uint32_t integrity() const { return load(&m_segment->integrity); }
+
+    uint32_t slaveIntegrity() const { return load(&m_segment->slaveIntegrity); }
+    void setSlaveIntegrity(uint32_t modes) { store(&m_segment->slaveIntegrity, modes); }
+
+    // Mode à demander au slave : requested s'il l'a annoncé, sinon aucun contrôle
+    uint32_t negotiatedIntegrity(uint32_t requested) const
+    {
+        return (slaveIntegrity() & requested) == requested ? requested : IPCIntegrity::NONE;
+    }
+
+    uint32_t control() const { return load(&m_segment->control); }
+    bool stopRequested() const { return control() == IPCControl::STOP; }
+
+    // Couvrent les octets contigus [request, requestCounter] et [responseCounter, response] :
+    // un message rejoué ou mélangé avec un autre compteur ne passe pas
+    static uint32_t requestChecksum(const Request& request, uint32_t requestCounter)
+    {
+        const uint32_t crc = Crc32c::compute(&request, sizeof(Request));
+        return Crc32c::update(crc, &requestCounter, sizeof(requestCounter));
+    }
+
+    static uint32_t responseChecksum(const Response& response, uint32_t responseCounter)
+    {
+        const uint32_t crc = Crc32c::compute(&responseCounter, sizeof(responseCounter));
+        return Crc32c::update(crc, &response, sizeof(Response));
+    }
+
+    // Segment laissé par un master précédent et encore exploitable :
+    // bon en-tête, flags connus, compteurs au plus à une requête d'écart
+    bool isConsistent() const
+    {
+        if (!isValid())
+            return false;
+
+        const uint32_t f = flags();
+        if (f != IPCFlags::IDLE && f != IPCFlags::MASTER_READY &&
+            f != IPCFlags::SLAVE_STARTED && f != IPCFlags::SLAVE_FINISHED)
+            return false;
+
+        const uint32_t gap = requestCounter() - responseCounter();
+        return gap <= 1;
+    }
+
+    // --- Côté master ---
+
+    // Écrit les inputs, efface les outputs puis publie MASTER_READY
+    void postRequest(const Request& request, uint32_t requestCounter, uint32_t integrity = IPCIntegrity::NONE)
+    {
+        memcpy(&m_segment->request, &request, sizeof(Request));
+        memset(&m_segment->response, 0, sizeof(Response));
+        store(&m_segment->requestCounter, requestCounter);
+        store(&m_segment->requestCrc, integrity == IPCIntegrity::CRC32C ? requestChecksum(request, requestCounter) : 0);
+        store(&m_segment->responseCrc, 0);
+        store(&m_segment->integrity, integrity);
+        store(&m_segment->partialHead, 0);
+        store(&m_segment->control, IPCControl::NONE);
+        store(&m_segment->flags, IPCFlags::MASTER_READY);
+    }
+
+    // Demande au slave d'arrêter le calcul en cours et de répondre avec ce qu'il a
+    void requestStop()
+    {
+        store(&m_segment->control, IPCControl::STOP);
+    }
+
+    // Copie les résultats partiels publiés depuis lastSequence (0 au début de la requête)
+    // Renvoie le nombre d'entrées perdues parce que l'anneau a tourné plus vite que la lecture
+    template<typename Fn>
+    uint32_t readPartials(uint32_t requestCounter, uint32_t& lastSequence, Fn&& onPartial) const
+    {
+        const uint32_t head = load(&m_segment->partialHead);
+        uint32_t lost = 0;
+
+        if (head - lastSequence > kPartialCount)
+        {
+            lost = head - lastSequence - kPartialCount;
+            lastSequence = head - kPartialCount;
+        }
+
+        while (lastSequence != head)
+        {
+            const uint32_t sequence = lastSequence + 1;
+            const IpcPartial* slot = &m_segment->partials[(sequence - 1) % kPartialCount];
+
+            IpcPartial partial;
+            const uint32_t before = load(&slot->sequence);
+            memcpy(&partial, slot, sizeof(IpcPartial));
+
+            // La copie doit être terminée avant la relecture : sans fence, ni le compilateur
+            // ni le processeur ne sont tenus de garder la relecture après le memcpy
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const uint32_t after = load(&slot->sequence);
+
+            // Entrée réécrite pendant la copie : le slave a déjà fait un tour de plus
+            if (before != sequence || after != sequence || partial.requestCounter != requestCounter)
+                lost++;
+            else
+                onPartial(partial);
+
+            lastSequence = sequence;
+        }
+
+        return lost;
+    }
+
+    // À appeler après avoir observé SLAVE_FINISHED
+    // Renvoie false si la réponse a changé pendant la copie ou ne correspond pas à sa somme de contrôle
+    bool readResponse(Response& out, uint32_t& responseCounter) const
+    {
+        responseCounter = load(&m_segment->responseCounter);
+        memcpy(&out, &m_segment->response, sizeof(Response));
+
+        if (load(&m_segment->responseCounter) != responseCounter)
+            return false;
+
+        if (integrity() == IPCIntegrity::CRC32C)
+            return load(&m_segment->responseCrc) == responseChecksum(out, responseCounter);
+
+        return true;
+    }
+
+    // --- Côté slave ---
+
+    // À appeler après avoir observé MASTER_READY
+    // Renvoie false si la requête a changé pendant la copie ou ne correspond pas à sa somme de contrôle
+    bool readRequest(Request& out, uint32_t& requestCounter) const
+    {
+        requestCounter = load(&m_segment->requestCounter);
+        memcpy(&out, &m_segment->request, sizeof(Request));
+
+        if (load(&m_segment->requestCounter) != requestCounter)
+            return false;
+
+        if (integrity() == IPCIntegrity::CRC32C)
+            return load(&m_segment->requestCrc) == requestChecksum(out, requestCounter);
+
+        return true;
+    }
+
+    // Réponse à servedCounter reprise par le master : flags a quitté SLAVE_FINISHED, ou une
+    // nouvelle requête est publiée. Le passage par IDLE entre deux requêtes de la file ne dure
+    // que quelques µs, un slave qui l'attendrait le manquerait
+    bool responseCollected(uint32_t servedCounter) const
+    {
+        return flags() != IPCFlags::SLAVE_FINISHED || requestCounter() != servedCounter;
+    }
+
+    void acceptRequest(uint32_t requestCounter)
+    {
+        store(&m_segment->responseCounter, requestCounter);
+        store(&m_segment->flags, IPCFlags::SLAVE_STARTED);
+    }
+
+    void postResponse(const Response& response)
+    {
+        memcpy(&m_segment->response, &response, sizeof(Response));
+        if (integrity() == IPCIntegrity::CRC32C)
+            store(&m_segment->responseCrc, responseChecksum(response, load(&m_segment->responseCounter)));
+        store(&m_segment->flags, IPCFlags::SLAVE_FINISHED);
+    }
+
+    // Publie un résultat partiel pour la requête en cours
+    void publishPartial(int64_t position, int64_t value)
+    {
+        const uint32_t sequence = load(&m_segment->partialHead) + 1;
+        IpcPartial* slot = &m_segment->partials[(sequence - 1) % kPartialCount];
+
+        // Entrée invalidée avant toute écriture des données (pendant de la fence de readPartials)
+        store(&slot->sequence, 0);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot->requestCounter = load(&m_segment->responseCounter);
+        slot->position = position;
+        slot->value = value;
+        store(&slot->sequence, sequence);
+        store(&m_segment->partialHead, sequence);
+    }
+
+    // Descripteur JSON du layout, consommé par les slaves non C++ (cf. slave.py)
+    static std::string layoutJson(const char* name)
+    {
+        std::string json = "{\n";
+        json += "  \"name\": \"" + std::string(name) + "\",\n";
+        json += "  \"size\": " + std::to_string(kSize) + ",\n";
+        json += "  \"magic\": " + std::to_string(IPC_MAGIC) + ",\n";
+        json += "  \"version\": " + std::to_string(IPC_VERSION) + ",\n";
+        json += "  \"fields\": [\n";
+
+        appendField(json, { "magic", kOffsetMagic, 4, IpcFieldType::UInt32 }, 0);
+        appendField(json, { "version", kOffsetVersion, 4, IpcFieldType::UInt32 }, 0);
+        for (const IpcField& field : IpcFieldList<Request>::fields)
+            appendField(json, field, kOffsetRequest);
+        appendField(json, { "requestCounter", kOffsetRequestCounter, 4, IpcFieldType::UInt32 }, 0);
+        appendField(json, { "responseCounter", kOffsetResponseCounter, 4, IpcFieldType::UInt32 }, 0);
+        for (const IpcField& field : IpcFieldList<Response>::fields)
+            appendField(json, field, kOffsetResponse);
+        appendField(json, { "flags", kOffsetFlags, 4, IpcFieldType::UInt32 }, 0);
+        appendField(json, { "masterPid", kOffsetMasterPid, 4, IpcFieldType::UInt32 }, 0);
+        appendField(json, { "slavePid", kOffsetSlavePid, 4, IpcFieldType::UInt32 }, 0);
+        appendField(json, { "integrity", kOffsetIntegrity, 4, IpcFieldType::UInt32 }, 0);
+        appendField(json, { "requestCrc", kOffsetRequestCrc, 4, IpcFieldType::UInt32 }, 0);
+        appendField(json, { "responseCrc", kOffsetResponseCrc, 4, IpcFieldType::UInt32 }, 0);
+        appendField(json, { "partialHead", kOffsetPartialHead, 4, IpcFieldType::UInt32 }, 0);
+        appendField(json, { "control", kOffsetControl, 4, IpcFieldType::UInt32 }, 0);
+        appendField(json, { "slaveIntegrity", kOffsetSlaveIntegrity, 4, IpcFieldType::UInt32 }, 0, true);
+        json += "  ],\n";
+
+        // Anneau de résultats partiels : entrées { sequence u32, requestCounter u32, position i64, value i64 }
+        json += "  \"partials\": { \"offset\": " + std::to_string(kOffsetPartials);
+        json += ", \"count\": " + std::to_string(kPartialCount);
+        json += ", \"recordSize\": " + std::to_string(sizeof(IpcPartial)) + " },\n";
+
+        // Plages couvertes par les sommes de contrôle : [offset, offset + size)
+        json += "  \"crc\": {\n";
+        json += "    \"algorithm\": \"crc32c\",\n";
+        json += "    \"request\": { \"offset\": " + std::to_string(kOffsetRequest);
+        json += ", \"size\": " + std::to_string(sizeof(Request) + 4) + " },\n";
+        json += "    \"response\": { \"offset\": " + std::to_string(kOffsetResponseCounter);
+        json += ", \"size\": " + std::to_string(4 + sizeof(Response)) + " }\n";
+        json += "  }\n}\n";
+        return json;
+    }
+
+private:
+    // Accès 32 bits alignés : atomiques sur x86/x64, les fences assurent l'ordre
+    // entre l'écriture des données et la publication des flags
+    static uint32_t load(const uint32_t* ptr)
+    {
+        uint32_t value = *static_cast<const volatile uint32_t*>(ptr);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return value;
+    }
+
+    static void store(uint32_t* ptr, uint32_t value)
+    {
+        std::atomic_thread_fence(std::memory_order_release);
+        *static_cast<volatile uint32_t*>(ptr) = value;
+    }
+
+    static void appendField(std::string& json, const IpcField& field, uint32_t base, bool last = false)
+    {
+        const char* type = "uint32";
+        if (field.type == IpcFieldType::Int32)
+            type = "int32";
+        else if (field.type == IpcFieldType::CString)
+            type = "cstring";
+
+        json += "    { \"name\": \"" + std::string(field.name) + "\"";
+        json += ", \"offset\": " + std::to_string(base + field.offset);
+        json += ", \"size\": " + std::to_string(field.size);
+        json += ", \"type\": \"" + std::string(type) + "\" }";
+        json += last ? "\n" : ",\n";
+    }
+
+private:
+    Segment* m_segment;
+};
@@ -0,0 +1,296 @@
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#include <mutex>
+#include <string>
+
+// Socket Unix (AF_UNIX) en flux, messages délimités par un en-tête de trame
+// Windows n'offre ni SOCK_SEQPACKET ni memfd : SOCK_STREAM + longueur explicite,
+// et pas de canal séparé pour les gros volumes (les messages du canal font < 300 octets)
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <afunix.h>
+#pragma comment(lib, "Ws2_32.lib")
+#else
+#include <errno.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+// Types de trame et limites du protocole
+namespace IPCFrame
+{
+    constexpr uint32_t MAGIC = 0x46435049;      // "IPCF"
+    constexpr uint16_t VERSION = 1;
+
+    constexpr uint16_t HELLO = 1;       // slave -> master, payload : pid (uint32), aux : modes d'intégrité supportés
+    constexpr uint16_t REQUEST = 2;     // master -> slave, payload : requête, aux : mode d'intégrité
+    constexpr uint16_t STARTED = 3;     // slave -> master, counter : requête acceptée
+    constexpr uint16_t PARTIAL = 4;     // slave -> master, payload : IpcPartial
+    constexpr uint16_t RESPONSE = 5;    // slave -> master, payload : réponse
+    constexpr uint16_t STOP = 6;        // master -> slave, arrêt du calcul en cours
+
+    constexpr uint32_t MAX_PAYLOAD = 4096;
+}
+
+#pragma pack(push, 1)
+// ### CHAMP ###   ### TAILLE ###
+// magic           4
+// version         2
+// type            2
+// counter         4    requestCounter ou responseCounter selon le sens
+// aux             4
+// crc             4    même couverture que requestCrc / responseCrc du segment
+// length          4    octets de payload qui suivent
+// TOTAL           24
+struct IpcFrameHeader
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t type;
+    uint32_t counter;
+    uint32_t aux;
+    uint32_t crc;
+    uint32_t length;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(IpcFrameHeader) == 24, "IpcFrameHeader size mismatch");
+
+class IpcSocket
+{
+public:
+    enum class Result
+    {
+        Frame,
+        Timeout,
+        Closed      // pair parti ou trame invalide : la connexion est fermée
+    };
+
+public:
+    IpcSocket() = default;
+    ~IpcSocket() { close(); }
+
+    IpcSocket(const IpcSocket&) = delete;
+    IpcSocket& operator=(const IpcSocket&) = delete;
+
+    // Chemin du socket associé à un canal, dans le dossier temporaire
+    static std::string pathFor(const std::string& channelName)
+    {
+#ifdef _WIN32
+        char dir[MAX_PATH + 1] = {};
+        const DWORD length = GetTempPathA(sizeof(dir), dir);
+        std::string path = length > 0 && length < sizeof(dir) ? std::string(dir, length) : std::string(".\\");
+#else
+        std::string path = "/tmp/";
+#endif
+        return path + channelName + ".sock";
+    }
+
+    bool isOpen() const { return m_handle != INVALID_HANDLE; }
+
+    // Côté master : un fichier laissé par un master précédent est remplacé
+    bool listen(const std::string& path)
+    {
+        sockaddr_un address;
+        if (!startup() || !makeAddress(path, address))
+            return false;
+
+        close();
+        removeFile(path);
+
+        m_handle = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (!isOpen())
+            return false;
+
+        if (::bind(m_handle, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+            ::listen(m_handle, 1) != 0)
+        {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    // Sur un socket en écoute : accepte une connexion arrivée dans le délai
+    bool accept(IpcSocket& client, int timeoutMs)
+    {
+        if (!waitReadable(timeoutMs))
+            return false;
+
+        const Handle handle = ::accept(m_handle, nullptr, nullptr);
+        if (handle == INVALID_HANDLE)
+            return false;
+
+        client.close();
+        client.m_handle = handle;
+        return true;
+    }
+
+    // Côté slave
+    bool connect(const std::string& path)
+    {
+        sockaddr_un address;
+        if (!startup() || !makeAddress(path, address))
+            return false;
+
+        close();
+
+        m_handle = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (!isOpen())
+            return false;
+
+        if (::connect(m_handle, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+        {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void close()
+    {
+        if (!isOpen())
+            return;
+#ifdef _WIN32
+        ::closesocket(m_handle);
+#else
+        ::close(m_handle);
+#endif
+        m_handle = INVALID_HANDLE;
+    }
+
+    // true si une lecture ne bloquera pas (données, connexion entrante ou fermeture)
+    bool waitReadable(int timeoutMs) const
+    {
+        if (!isOpen())
+            return false;
+
+        fd_set readable;
+        FD_ZERO(&readable);
+        FD_SET(m_handle, &readable);
+
+        timeval timeout;
+        timeout.tv_sec = timeoutMs / 1000;
+        timeout.tv_usec = (timeoutMs % 1000) * 1000;
+
+        return ::select(static_cast<int>(m_handle) + 1, &readable, nullptr, nullptr, &timeout) > 0;
+    }
+
+    // Envoi d'une trame complète, sûr depuis plusieurs threads
+    bool sendFrame(uint16_t type, uint32_t counter, uint32_t aux, uint32_t crc, const void* payload, uint32_t length)
+    {
+        IpcFrameHeader header = { IPCFrame::MAGIC, IPCFrame::VERSION, type, counter, aux, crc, length };
+
+        std::lock_guard<std::mutex> lock(m_sendMutex);
+        return sendAll(&header, sizeof(header)) && (length == 0 || sendAll(payload, length));
+    }
+
+    bool sendFrame(uint16_t type, uint32_t counter = 0)
+    {
+        return sendFrame(type, counter, 0, 0, nullptr, 0);
+    }
+
+    // Attend au plus timeoutMs le début d'une trame, puis la lit en entier
+    Result receiveFrame(IpcFrameHeader& header, void* payload, uint32_t capacity, int timeoutMs)
+    {
+        if (!waitReadable(timeoutMs))
+            return isOpen() ? Result::Timeout : Result::Closed;
+
+        if (!receiveAll(&header, sizeof(header)) ||
+            header.magic != IPCFrame::MAGIC || header.version != IPCFrame::VERSION ||
+            header.length > capacity ||
+            (header.length > 0 && !receiveAll(payload, header.length)))
+        {
+            close();
+            return Result::Closed;
+        }
+        return Result::Frame;
+    }
+
+private:
+#ifdef _WIN32
+    using Handle = SOCKET;
+    static constexpr Handle INVALID_HANDLE = INVALID_SOCKET;
+#else
+    using Handle = int;
+    static constexpr Handle INVALID_HANDLE = -1;
+#endif
+
+    static bool startup()
+    {
+#ifdef _WIN32
+        // Une fois par process, jamais libéré
+        static const bool started = []()
+        {
+            WSADATA data;
+            return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+        }();
+        return started;
+#else
+        return true;
+#endif
+    }
+
+    static bool makeAddress(const std::string& path, sockaddr_un& address)
+    {
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(address.sun_path))
+            return false;
+        memcpy(address.sun_path, path.c_str(), path.size());
+        return true;
+    }
+
+    static void removeFile(const std::string& path)
+    {
+#ifdef _WIN32
+        DeleteFileA(path.c_str());
+#else
+        ::unlink(path.c_str());
+#endif
+    }
+
+    bool sendAll(const void* data, size_t size)
+    {
+        const char* bytes = static_cast<const char*>(data);
+        while (size > 0)
+        {
+#ifdef _WIN32
+            const int sent = ::send(m_handle, bytes, static_cast<int>(size), 0);
+#else
+            const ssize_t sent = ::send(m_handle, bytes, size, MSG_NOSIGNAL);
+#endif
+            if (sent <= 0)
+                return false;
+            bytes += sent;
+            size -= static_cast<size_t>(sent);
+        }
+        return true;
+    }
+
+    bool receiveAll(void* data, size_t size)
+    {
+        char* bytes = static_cast<char*>(data);
+        while (size > 0)
+        {
+#ifdef _WIN32
+            const int received = ::recv(m_handle, bytes, static_cast<int>(size), 0);
+#else
+            const ssize_t received = ::recv(m_handle, bytes, size, 0);
+#endif
+            if (received <= 0)
+                return false;
+            bytes += received;
+            size -= static_cast<size_t>(received);
+        }
+        return true;
+    }
+
+private:
+    Handle m_handle = INVALID_HANDLE;
+    std::mutex m_sendMutex;
+};
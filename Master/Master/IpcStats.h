@@ -0,0 +1,227 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include "SharedData.h"
+
+#ifndef IPC_STATS_MAGIC
+#define IPC_STATS_MAGIC 0x57A7C0DE
+#endif // !IPC_STATS_MAGIC
+
+#ifndef IPC_STATS_VERSION
+#define IPC_STATS_VERSION 2
+#endif // !IPC_STATS_VERSION
+
+// Nom du mapping de statistiques associé à un canal : "<canal>_stats"
+#ifndef IPC_STATS_SUFFIX
+#define IPC_STATS_SUFFIX "_stats"
+#endif // !IPC_STATS_SUFFIX
+
+// Codes d'erreur comptés séparément, le dernier slot regroupe les autres
+namespace IpcStatsErrors
+{
+    constexpr int32_t CODES[] = {
+        IPCErrorCode::SUCCESS,
+        IPCErrorCode::START_GREATER_THAN_END,
+        IPCErrorCode::OVERFLOW_ERROR,
+        IPCErrorCode::FILE_WRITE_ERROR,
+        IPCErrorCode::STOPPED,
+        IPCErrorCode::TIMEOUT_ERROR,
+        IPCErrorCode::INTEGRITY_ERROR,
+        IPCErrorCode::INVALID_RESPONSE_COUNTER,
+        IPCErrorCode::UNKNOWN_ERROR,
+    };
+
+    constexpr uint32_t COUNT = sizeof(CODES) / sizeof(CODES[0]);
+    constexpr uint32_t SLOTS = COUNT + 1;
+    constexpr uint32_t OTHER = COUNT;
+
+    constexpr uint32_t slot(int32_t code)
+    {
+        for (uint32_t i = 0; i < COUNT; ++i)
+        {
+            if (CODES[i] == code)
+                return i;
+        }
+        return OTHER;
+    }
+}
+
+// Compteurs d'un côté du canal, écrits par un seul thread d'un seul process
+// Tous les champs sont des uint64 alignés : lecture sans verrou depuis un autre process
+//
+// ### CHAMP ###            ### OFFSET ###
+// pid                      0
+// heartbeatMs              8
+// requests                 16
+// responses                24
+// errors[10]               32
+// counterMismatches        112
+// timeouts                 120
+// busyNs                   128
+// idleNs                   136
+// bytesIn                  144
+// bytesOut                 152
+//
+// TOTAL                    192 (une ligne de cache par bloc + padding)
+struct alignas(64) IpcStatsBlock
+{
+    uint64_t pid;
+    uint64_t heartbeatMs;       // horloge murale (ms depuis epoch) de la dernière écriture
+    uint64_t requests;          // master : requêtes publiées, slave : requêtes acceptées
+    uint64_t responses;         // master : réponses lues, slave : réponses publiées
+    uint64_t errors[IpcStatsErrors::SLOTS];
+    uint64_t counterMismatches;
+    uint64_t timeouts;
+    uint64_t busyNs;            // master : requête en vol, slave : calcul en cours
+    uint64_t idleNs;
+    uint64_t bytesIn;
+    uint64_t bytesOut;
+};
+
+// Région complète : en-tête puis un bloc par écrivain
+struct alignas(64) IpcStatsRegion
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t blockSize;
+    uint32_t errorSlots;
+
+    IpcStatsBlock master;       // écrit par le thread du modèle côté master
+    IpcStatsBlock slave;        // écrit par le slave qui sert le canal
+};
+
+static_assert(offsetof(IpcStatsBlock, errors) == 32, "errors offset mismatch");
+static_assert(offsetof(IpcStatsBlock, counterMismatches) == 112, "counterMismatches offset mismatch");
+static_assert(offsetof(IpcStatsBlock, bytesOut) == 152, "bytesOut offset mismatch");
+static_assert(sizeof(IpcStatsBlock) == 192, "IpcStatsBlock size mismatch");
+static_assert(offsetof(IpcStatsRegion, master) == 64, "master block offset mismatch");
+static_assert(offsetof(IpcStatsRegion, slave) == 256, "slave block offset mismatch");
+static_assert(sizeof(IpcStatsRegion) == 448, "IpcStatsRegion size mismatch");
+
+namespace IpcStats
+{
+    inline std::string regionName(const std::string& channelName)
+    {
+        return channelName + IPC_STATS_SUFFIX;
+    }
+
+    inline bool isValid(const IpcStatsRegion* region)
+    {
+        return region && region->magic == IPC_STATS_MAGIC && region->version == IPC_STATS_VERSION &&
+            region->blockSize == sizeof(IpcStatsBlock) && region->errorSlots == IpcStatsErrors::SLOTS;
+    }
+
+    // Remise à zéro (côté master uniquement, avant que les écrivains ne s'attachent)
+    inline void initialize(IpcStatsRegion* region)
+    {
+        memset(static_cast<void*>(region), 0, sizeof(IpcStatsRegion));
+        region->version = IPC_STATS_VERSION;
+        region->blockSize = sizeof(IpcStatsBlock);
+        region->errorSlots = IpcStatsErrors::SLOTS;
+        std::atomic_thread_fence(std::memory_order_release);
+        region->magic = IPC_STATS_MAGIC;
+    }
+
+    // Accès 64 bits alignés : atomiques sur x64, jamais de valeur déchirée côté lecteur
+    inline uint64_t load(const uint64_t* ptr)
+    {
+        return *static_cast<const volatile uint64_t*>(ptr);
+    }
+
+    inline void store(uint64_t* ptr, uint64_t value)
+    {
+        *static_cast<volatile uint64_t*>(ptr) = value;
+    }
+
+    // Copie champ par champ d'un bloc écrit par un autre process
+    inline IpcStatsBlock snapshot(const IpcStatsBlock* block)
+    {
+        IpcStatsBlock copy;
+        const uint64_t* src = reinterpret_cast<const uint64_t*>(block);
+        uint64_t* dst = reinterpret_cast<uint64_t*>(&copy);
+        for (size_t i = 0; i < sizeof(IpcStatsBlock) / sizeof(uint64_t); ++i)
+            dst[i] = load(src + i);
+        return copy;
+    }
+
+    inline uint64_t wallClockMs()
+    {
+        using namespace std::chrono;
+        return static_cast<uint64_t>(duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count());
+    }
+}
+
+// Écrivain d'un bloc : un seul par bloc, les incréments sont de simples load + store
+class IpcStatsWriter
+{
+public:
+    explicit IpcStatsWriter(IpcStatsBlock* block = nullptr)
+    {
+        attach(block);
+    }
+
+    void attach(IpcStatsBlock* block)
+    {
+        m_block = block;
+        m_busy = false;
+        m_lastTransition = std::chrono::steady_clock::now();
+    }
+
+    bool isAttached() const { return m_block != nullptr; }
+
+    void setPid(uint32_t pid)
+    {
+        if (m_block)
+            IpcStats::store(&m_block->pid, pid);
+        heartbeat();
+    }
+
+    void add(uint64_t IpcStatsBlock::* field, uint64_t delta = 1)
+    {
+        if (m_block)
+            increment(&(m_block->*field), delta);
+    }
+
+    void addError(int32_t code)
+    {
+        if (m_block)
+            increment(&m_block->errors[IpcStatsErrors::slot(code)], 1);
+    }
+
+    // Bascule occupé / au repos, le temps écoulé est versé au compteur de l'état quitté
+    void setBusy(bool busy)
+    {
+        if (busy == m_busy)
+            return;
+
+        const auto now = std::chrono::steady_clock::now();
+        const uint64_t elapsed = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_lastTransition).count());
+
+        add(m_busy ? &IpcStatsBlock::busyNs : &IpcStatsBlock::idleNs, elapsed);
+        m_busy = busy;
+        m_lastTransition = now;
+        heartbeat();
+    }
+
+    void heartbeat()
+    {
+        if (m_block)
+            IpcStats::store(&m_block->heartbeatMs, IpcStats::wallClockMs());
+    }
+
+private:
+    static void increment(uint64_t* ptr, uint64_t delta)
+    {
+        IpcStats::store(ptr, IpcStats::load(ptr) + delta);
+    }
+
+private:
+    IpcStatsBlock* m_block = nullptr;
+    bool m_busy = false;
+    std::chrono::steady_clock::time_point m_lastTransition;
+};
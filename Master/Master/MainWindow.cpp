@@ -6,16 +6,33 @@ MainWindow::MainWindow(QWidget* parent) :
     ui.setupUi(this);
 
     connect(ui.startPushButton, &QPushButton::clicked, this, &MainWindow::onStartClicked);
+    connect(ui.stopPushButton, &QPushButton::clicked, this, &MainWindow::stopRequested);
     connect(ui.folderPushButton, &QPushButton::clicked, this, &MainWindow::onFolderClicked);
     connect(ui.startSpinBox, QOverload<int>::of(&QSpinBox::valueChanged), this, &MainWindow::onStartSpinChanged);
     connect(ui.endSpinBox, QOverload<int>::of(&QSpinBox::valueChanged), this, &MainWindow::onEndSpinChanged);
-    connect(ui.scriptNameLineEdit, &QLineEdit::textEdited, this, &MainWindow::scriptNameChanged);
+    // Validé à la fin de la saisie : changer de slave relance les slaves supervisés
+    connect(ui.scriptNameLineEdit, &QLineEdit::editingFinished, this, [this]()
+    {
+        emit scriptNameChanged(ui.scriptNameLineEdit->text());
+    });
+    connect(ui.transportComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &MainWindow::transportChanged);
+    connect(ui.sweepRunPushButton, &QPushButton::clicked, this, [this]()
+    {
+        emit sweepRequested(ui.sweepSpecTextEdit->toPlainText(), ui.sweepRepeatSpinBox->value());
+    });
+    connect(ui.sweepStopPushButton, &QPushButton::clicked, this, &MainWindow::sweepStopRequested);
+    connect(ui.sweepExportPushButton, &QPushButton::clicked, this, &MainWindow::sweepExportRequested);
 
     updateStartButtonState();
 }
 
 MainWindow::~MainWindow() {}
 
+void MainWindow::setResultModel(QAbstractItemModel* model)
+{
+    ui.fileListView->setModel(model);
+}
+
 void MainWindow::onStartClicked()
 {
     emit startRequested();
@@ -44,12 +61,14 @@ void MainWindow::updateStartButtonState()
 {
     bool valid = !ui.folderLineEdit->text().isEmpty() && m_slaveProcessFound;
     ui.startPushButton->setEnabled(valid);
+    ui.sweepRunPushButton->setEnabled(valid && !ui.sweepStopPushButton->isEnabled());
 }
 
 void MainWindow::updateProcessInfo(const QString& scriptName, bool found, int pid, const QString& masterState, const QString& slaveState)
 {
     m_slaveProcessFound = found;
-    ui.scriptNameLineEdit->setText(scriptName);
+    if (!ui.scriptNameLineEdit->hasFocus())
+        ui.scriptNameLineEdit->setText(scriptName);
     ui.slaveProcessLabel->setText(found ? "Found" : "Not found");
     ui.slaveProcessIdLabel->setText(QString::number(pid));
     ui.masterStateLabel->setText(masterState);
@@ -58,17 +77,23 @@ void MainWindow::updateProcessInfo(const QString& scriptName, bool found, int pi
     updateStartButtonState();
 }
 
-void MainWindow::updateTelemetry(qint64 masterMs, qint64 slaveMs)
+void MainWindow::updateTelemetry(qint64 masterMs, qint64 slaveMs, int queueDepth, int queueCapacity, qint64 queueWaitMs, qint64 queueWaitMaxMs)
 {
     ui.elapsedTimeMasterLabel->setText(QString::number(masterMs));
     ui.elapsedTimeSlaveLabel->setText(QString::number(slaveMs));
+    ui.queueDepthLabel->setText(QString("%1 / %2").arg(queueDepth).arg(queueCapacity));
+    ui.queueWaitLabel->setText(QString("%1 / %2").arg(queueWaitMs).arg(queueWaitMaxMs));
 }
 
-void MainWindow::updateOutputs(int statusCode, int sumResult, const QString& fileContent)
+void MainWindow::updateOutputs(int statusCode, int sumResult)
 {
     ui.statusCodeLabel->setText(QString::number(statusCode));
     ui.sumResultLabel->setText(QString::number(sumResult));
-    ui.fileTextEdit->setPlainText(fileContent);
+}
+
+void MainWindow::updatePartial(qint64 position, qint64 value)
+{
+    ui.partialResultLabel->setText(QString("%1 (up to %2)").arg(value).arg(position));
 }
 
 void MainWindow::updateInputs(const QString& folder, int start, int end)
@@ -87,3 +112,21 @@ void MainWindow::updateInputs(const QString& folder, int start, int end)
 
     updateStartButtonState();
 }
+
+void MainWindow::clearSweep()
+{
+    ui.sweepChart->clear();
+    ui.sweepProgressLabel->setText("---");
+}
+
+void MainWindow::addSweepPoint(double masterMs, double slaveMs, double throughput)
+{
+    ui.sweepChart->addPoint(masterMs, slaveMs, throughput);
+}
+
+void MainWindow::updateSweepProgress(int done, int total, bool running)
+{
+    ui.sweepProgressLabel->setText(QString("%1 / %2").arg(done).arg(total));
+    ui.sweepStopPushButton->setEnabled(running);
+    updateStartButtonState();
+}
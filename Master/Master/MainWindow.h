@@ -11,19 +11,31 @@ public:
     MainWindow(QWidget* parent = nullptr);
     ~MainWindow();
 
+    void setResultModel(QAbstractItemModel* model);
+
 signals:
     void startRequested();
+    void stopRequested();
     void folderRequested();
     void rangeChanged(int start, int end);
     void folderChanged(const QString& folder);
     void scriptNameChanged(const QString& scriptName);
+    void transportChanged(int index);
+    void sweepRequested(const QString& spec, int repeat);
+    void sweepStopRequested();
+    void sweepExportRequested();
 
 public slots:
     void updateProcessInfo(const QString& scriptName, bool found, int pid, const QString& masterState, const QString& slaveState);
-    void updateTelemetry(qint64 masterMs, qint64 slaveMs);
-    void updateOutputs(int statusCode, int sumResult, const QString& fileContent);
+    void updateTelemetry(qint64 masterMs, qint64 slaveMs, int queueDepth, int queueCapacity, qint64 queueWaitMs, qint64 queueWaitMaxMs);
+    void updateOutputs(int statusCode, int sumResult);
+    void updatePartial(qint64 position, qint64 value);
     void updateInputs(const QString& folder, int start, int end);
 
+    void clearSweep();
+    void addSweepPoint(double masterMs, double slaveMs, double throughput);
+    void updateSweepProgress(int done, int total, bool running);
+
 private slots:
     void onStartClicked();
     void onFolderClicked();
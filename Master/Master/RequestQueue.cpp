@@ -0,0 +1,154 @@
+#include "RequestQueue.h"
+#include <iterator>
+
+RequestQueue::RequestQueue(int capacity, OverflowPolicy policy) :
+	m_capacity(qMax(1, capacity)),
+	m_policy(policy)
+{
+}
+
+void RequestQueue::setCapacity(int capacity)
+{
+	QMutexLocker locker(&m_mutex);
+	m_capacity = qMax(1, capacity);
+	m_notFull.wakeAll();
+}
+
+int RequestQueue::capacity() const
+{
+	QMutexLocker locker(&m_mutex);
+	return m_capacity;
+}
+
+void RequestQueue::setPolicy(OverflowPolicy policy)
+{
+	QMutexLocker locker(&m_mutex);
+	m_policy = policy;
+	m_notFull.wakeAll();
+}
+
+RequestQueue::OverflowPolicy RequestQueue::policy() const
+{
+	QMutexLocker locker(&m_mutex);
+	return m_policy;
+}
+
+RequestQueue::PushResult RequestQueue::push(const QueuedRequest& request, QueuedRequest* dropped, bool mayBlock)
+{
+	QMutexLocker locker(&m_mutex);
+
+	PushResult result = PushResult::Queued;
+
+	if (m_size >= m_capacity)
+	{
+		switch (m_policy)
+		{
+		case OverflowPolicy::Reject:
+			return PushResult::Rejected;
+
+		case OverflowPolicy::Block:
+			if (!mayBlock)
+				return PushResult::Rejected;
+
+			while (m_size >= m_capacity && m_policy == OverflowPolicy::Block)
+				m_notFull.wait(&m_mutex);
+
+			// La politique a pu changer pendant l'attente
+			if (m_size >= m_capacity)
+			{
+				if (m_policy == OverflowPolicy::Reject || !dropOldestLocked(request.priority, dropped))
+					return PushResult::Rejected;
+				result = PushResult::QueuedDroppedOldest;
+			}
+			break;
+
+		case OverflowPolicy::DropOldest:
+			if (!dropOldestLocked(request.priority, dropped))
+				return PushResult::Rejected;
+			result = PushResult::QueuedDroppedOldest;
+			break;
+		}
+	}
+
+	m_levels[request.priority].enqueue(request);
+	m_size++;
+	return result;
+}
+
+bool RequestQueue::pop(QueuedRequest& out)
+{
+	QMutexLocker locker(&m_mutex);
+
+	if (m_levels.isEmpty())
+		return false;
+
+	// QMap est trié par clé croissante : la plus haute priorité est en dernier
+	auto it = std::prev(m_levels.end());
+	out = it->dequeue();
+	if (it->isEmpty())
+		m_levels.erase(it);
+
+	m_size--;
+	m_notFull.wakeOne();
+	return true;
+}
+
+bool RequestQueue::remove(quint64 id)
+{
+	QMutexLocker locker(&m_mutex);
+
+	for (auto it = m_levels.begin(); it != m_levels.end(); ++it)
+	{
+		for (qsizetype i = 0; i < it->size(); ++i)
+		{
+			if (it->at(i).id != id)
+				continue;
+
+			it->removeAt(i);
+			if (it->isEmpty())
+				m_levels.erase(it);
+
+			m_size--;
+			m_notFull.wakeOne();
+			return true;
+		}
+	}
+	return false;
+}
+
+int RequestQueue::size() const
+{
+	QMutexLocker locker(&m_mutex);
+	return m_size;
+}
+
+bool RequestQueue::isEmpty() const
+{
+	return size() == 0;
+}
+
+void RequestQueue::clear()
+{
+	QMutexLocker locker(&m_mutex);
+	m_levels.clear();
+	m_size = 0;
+	m_notFull.wakeAll();
+}
+
+bool RequestQueue::dropOldestLocked(int priority, QueuedRequest* dropped)
+{
+	// Tout ce qui attend passe avant la nouvelle requête : c'est elle qu'on refuse
+	if (m_levels.isEmpty() || m_levels.firstKey() > priority)
+		return false;
+
+	// Niveau le moins prioritaire, requête la plus ancienne
+	auto it = m_levels.begin();
+	QueuedRequest oldest = it->dequeue();
+	if (it->isEmpty())
+		m_levels.erase(it);
+
+	m_size--;
+	if (dropped)
+		*dropped = oldest;
+	return true;
+}
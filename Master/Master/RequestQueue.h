@@ -0,0 +1,72 @@
+#pragma once
+
+#include "SharedData.h"
+
+#include <QMap>
+#include <QMutex>
+#include <QQueue>
+#include <QWaitCondition>
+#include <QElapsedTimer>
+
+// Requête en attente du slave
+struct QueuedRequest
+{
+    quint64 id = 0;
+    int priority = 0;           // plus grand = plus prioritaire
+    SumRequest request{};
+    QElapsedTimer enqueued;     // pour mesurer le temps d'attente
+};
+
+// File bornée, ordonnée par priorité puis FIFO
+// Thread-safe : push peut venir de n'importe quel thread, pop du thread du modèle
+class RequestQueue
+{
+public:
+    enum class OverflowPolicy
+    {
+        Reject,     // la nouvelle requête est refusée
+        Block,      // l'appelant attend une place (jamais depuis le thread qui dépile)
+        DropOldest  // la plus ancienne des moins prioritaires est abandonnée,
+                    // sauf si la nouvelle est moins prioritaire que toutes (refusée)
+    };
+
+    enum class PushResult
+    {
+        Queued,
+        Rejected,
+        QueuedDroppedOldest
+    };
+
+    explicit RequestQueue(int capacity = 64, OverflowPolicy policy = OverflowPolicy::Reject);
+
+    void setCapacity(int capacity);
+    int capacity() const;
+
+    void setPolicy(OverflowPolicy policy);
+    OverflowPolicy policy() const;
+
+    // dropped est rempli quand PushResult::QueuedDroppedOldest
+    // mayBlock = false : avec Block et la file pleine, refus immédiat au lieu d'attendre
+    // (thread qui dépile), décidé sous le même verrou que l'insertion
+    PushResult push(const QueuedRequest& request, QueuedRequest* dropped = nullptr, bool mayBlock = true);
+    bool pop(QueuedRequest& out);
+
+    // Retire une requête encore en attente, false si elle n'est plus dans la file
+    bool remove(quint64 id);
+
+    int size() const;
+    bool isEmpty() const;
+    void clear();
+
+private:
+    // false si la nouvelle requête (priority) est moins prioritaire que toutes les autres
+    bool dropOldestLocked(int priority, QueuedRequest* dropped);
+
+    mutable QMutex m_mutex;
+    QWaitCondition m_notFull;
+
+    QMap<int, QQueue<QueuedRequest>> m_levels;  // clé = priorité
+    int m_size = 0;
+    int m_capacity;
+    OverflowPolicy m_policy;
+};
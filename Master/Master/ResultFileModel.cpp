@@ -0,0 +1,262 @@
+#include "ResultFileModel.h"
+#include <QDebug>
+#include <QThread>
+#include <string.h>
+
+// Lignes publiées par lot pendant l'indexation
+static constexpr int INDEX_BATCH_LINES = 64 * 1024;
+
+// Au-delà, la ligne est tronquée à l'affichage
+static constexpr qint64 MAX_DISPLAYED_LINE = 4096;
+
+// Relue d'un bloc pour l'affichage : quelques milliers de lignes courtes
+static constexpr qint64 DISPLAY_WINDOW = 256 * 1024;
+
+// Copié à l'ouverture pour extraire la durée
+static constexpr qint64 HEAD_SIZE = 64 * 1024;
+
+ResultFileModel::ResultFileModel(QObject* parent) :
+	QAbstractListModel(parent)
+{
+}
+
+ResultFileModel::~ResultFileModel()
+{
+	stopIndexing();
+}
+
+bool ResultFileModel::open(const QString& path)
+{
+	clear();
+
+	m_file.setFileName(path);
+	if (!m_file.open(QIODevice::ReadOnly))
+		return false;
+
+	m_size = m_file.size();
+	if (m_size > 0)
+	{
+		m_data = m_file.map(0, m_size);
+		if (!m_data)
+		{
+			m_file.close();
+			m_size = 0;
+			return false;
+		}
+		m_head = QByteArray(reinterpret_cast<const char*>(m_data), static_cast<int>(qMin(m_size, HEAD_SIZE)));
+	}
+
+	startIndexing();
+	return true;
+}
+
+void ResultFileModel::setMessage(const QString& text)
+{
+	clear();
+
+	beginResetModel();
+	m_message = text;
+	endResetModel();
+}
+
+void ResultFileModel::clear()
+{
+	stopIndexing();
+
+	beginResetModel();
+	m_lineEnds.clear();
+	m_message.clear();
+	releaseMapping();
+	m_size = 0;
+	m_head.clear();
+	m_window.clear();
+	m_windowStart = 0;
+	endResetModel();
+}
+
+void ResultFileModel::releaseMapping()
+{
+	if (m_data)
+	{
+		m_file.unmap(m_data);
+		m_data = nullptr;
+	}
+	m_file.close();
+}
+
+void ResultFileModel::stopIndexing()
+{
+	if (!m_indexer)
+		return;
+
+	// Le thread lit le mapping : on l'arrête avant tout unmap
+	m_cancel = true;
+	m_indexer->wait();
+	delete m_indexer;
+	m_indexer = nullptr;
+	m_cancel = false;
+	m_generation++;
+}
+
+void ResultFileModel::startIndexing()
+{
+	const quint64 generation = ++m_generation;
+	const char* data = reinterpret_cast<const char*>(m_data);
+	const qint64 size = m_size;
+
+	m_indexer = QThread::create([this, data, size, generation]()
+	{
+		QVector<qint64> batch;
+		batch.reserve(INDEX_BATCH_LINES);
+
+		qint64 pos = 0;
+		while (pos < size && !m_cancel)
+		{
+			const void* nl = memchr(data + pos, '\n', static_cast<size_t>(size - pos));
+			const qint64 end = nl ? static_cast<const char*>(nl) - data : size;
+			batch.append(end);
+			pos = end + 1;
+
+			if (batch.size() == INDEX_BATCH_LINES)
+			{
+				QMetaObject::invokeMethod(this, [this, generation, batch]() { appendLines(generation, batch); }, Qt::QueuedConnection);
+				batch.clear();
+				batch.reserve(INDEX_BATCH_LINES);
+			}
+		}
+
+		if (!batch.isEmpty() && !m_cancel)
+			QMetaObject::invokeMethod(this, [this, generation, batch]() { appendLines(generation, batch); }, Qt::QueuedConnection);
+
+		QMetaObject::invokeMethod(this, [this, generation]() { finishIndexing(generation); }, Qt::QueuedConnection);
+	});
+
+	m_indexer->start();
+}
+
+void ResultFileModel::appendLines(quint64 generation, const QVector<qint64>& lineEnds)
+{
+	if (generation != m_generation)
+		return;
+
+	const int first = m_lineEnds.size();
+	beginInsertRows(QModelIndex(), first, first + lineEnds.size() - 1);
+	m_lineEnds += lineEnds;
+	endInsertRows();
+}
+
+void ResultFileModel::finishIndexing(quint64 generation)
+{
+	if (generation != m_generation || !m_indexer)
+		return;
+
+	m_indexer->wait();
+	delete m_indexer;
+	m_indexer = nullptr;
+
+	// L'index suffit désormais : ne pas garder le fichier ouvert
+	releaseMapping();
+
+	emit indexingFinished(m_lineEnds.size());
+}
+
+int ResultFileModel::rowCount(const QModelIndex& parent) const
+{
+	if (parent.isValid())
+		return 0;
+
+	if (!m_message.isEmpty())
+		return 1;
+
+	return m_lineEnds.size();
+}
+
+QVariant ResultFileModel::data(const QModelIndex& index, int role) const
+{
+	if (role != Qt::DisplayRole || !index.isValid())
+		return QVariant();
+
+	if (!m_message.isEmpty())
+		return m_message;
+
+	const int row = index.row();
+	if (row < 0 || row >= m_lineEnds.size())
+		return QVariant();
+
+	const qint64 start = row == 0 ? 0 : m_lineEnds[row - 1] + 1;
+	const qint64 fullLength = m_lineEnds[row] - start;
+
+	// Une ligne tronquée n'a besoin que de son début (+ 1 pour un éventuel '\r')
+	const qint64 needed = qMin(fullLength, MAX_DISPLAYED_LINE + 1);
+	if (!loadWindow(start, needed))
+		return QVariant();
+
+	const char* line = m_window.constData() + (start - m_windowStart);
+	qint64 length = fullLength;
+	if (length <= MAX_DISPLAYED_LINE && length > 0 && line[length - 1] == '\r')
+		length--;
+
+	if (length > MAX_DISPLAYED_LINE)
+		return QString::fromUtf8(line, MAX_DISPLAYED_LINE) + QStringLiteral("…");
+
+	return QString::fromUtf8(line, static_cast<int>(length));
+}
+
+bool ResultFileModel::loadWindow(qint64 start, qint64 length) const
+{
+	if (start >= m_windowStart && start + length <= m_windowStart + m_window.size())
+		return true;
+
+	// Fichier rouvert le temps de la lecture seulement
+	QFile file(m_file.fileName());
+	if (!file.open(QIODevice::ReadOnly) || !file.seek(start))
+		return false;
+
+	m_window = file.read(qMax(length, DISPLAY_WINDOW));
+	m_windowStart = start;
+
+	// Fichier raccourci ou réécrit depuis l'indexation
+	return m_window.size() >= length;
+}
+
+bool ResultFileModel::extractDuration(const char* data, qint64 size, quint64& elapsedOut)
+{
+	static constexpr char prefix[] = "Duration:";
+	static constexpr qint64 prefixLength = sizeof(prefix) - 1;
+
+	bool found = false;
+	qint64 pos = 0;
+
+	while (pos < size)
+	{
+		const void* nl = memchr(data + pos, '\n', static_cast<size_t>(size - pos));
+		const qint64 end = nl ? static_cast<const char*>(nl) - data : size;
+
+		if (end - pos > prefixLength && memcmp(data + pos, prefix, prefixLength) == 0)
+		{
+			// Parse sans allocation, espaces tolérés avant la valeur
+			qint64 i = pos + prefixLength;
+			while (i < end && data[i] == ' ')
+				i++;
+
+			quint64 value = 0;
+			qint64 digits = 0;
+			while (i < end && data[i] >= '0' && data[i] <= '9')
+			{
+				value = value * 10 + static_cast<quint64>(data[i] - '0');
+				i++;
+				digits++;
+			}
+
+			if (digits > 0)
+			{
+				elapsedOut = value;
+				found = true;
+			}
+		}
+
+		pos = end + 1;
+	}
+
+	return found;
+}
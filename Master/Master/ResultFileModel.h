@@ -0,0 +1,68 @@
+#pragma once
+
+#include <QAbstractListModel>
+#include <QFile>
+#include <QString>
+#include <QVector>
+
+#include <atomic>
+
+class QThread;
+
+// Fichier résultat exposé ligne par ligne
+// Le texte n'est jamais copié en entier : chaque ligne est décodée à l'affichage
+// L'index des lignes est construit hors du thread UI sur un mapping du fichier, publié par lots,
+// puis le mapping est libéré : le slave peut réécrire ou supprimer le fichier (Windows refuse
+// tant qu'une vue est ouverte). L'affichage relit une fenêtre bornée autour des lignes demandées
+class ResultFileModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    explicit ResultFileModel(QObject* parent = nullptr);
+    ~ResultFileModel() override;
+
+    bool open(const QString& path);
+    void setMessage(const QString& text);   // affiche une seule ligne, sans fichier
+    void clear();
+
+    bool isIndexing() const { return m_indexer != nullptr; }
+    qint64 size() const { return m_size; }
+
+    // Début du fichier, copié à l'ouverture (la durée y est écrite par le slave)
+    const QByteArray& head() const { return m_head; }
+
+    // Cherche la dernière ligne "Duration: <ms>" dans data[0..size)
+    static bool extractDuration(const char* data, qint64 size, quint64& elapsedOut);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+signals:
+    void indexingFinished(int lineCount);
+
+private:
+    void stopIndexing();
+    void startIndexing();
+    void appendLines(quint64 generation, const QVector<qint64>& lineEnds);
+    void finishIndexing(quint64 generation);
+    void releaseMapping();
+
+    // Lit dans m_window les octets [start, start + length), au moins
+    bool loadWindow(qint64 start, qint64 length) const;
+
+    QFile m_file;
+    uchar* m_data = nullptr;        // mapping, seulement pendant l'indexation
+    qint64 m_size = 0;
+    QByteArray m_head;
+
+    mutable QByteArray m_window;    // fenêtre relue du fichier pour l'affichage
+    mutable qint64 m_windowStart = 0;
+
+    QVector<qint64> m_lineEnds;     // offset du '\n' terminant chaque ligne (ou fin de fichier)
+    QString m_message;
+
+    QThread* m_indexer = nullptr;
+    std::atomic<bool> m_cancel{ false };
+    quint64 m_generation = 0;       // ignore les lots d'une indexation précédente
+};
@@ -1,18 +1,11 @@
 #pragma once
 #include <stdint.h>
+#include "IpcChannel.h"
 
 #ifndef EXPECTED_SHARED_DATA_SIZE
-#define EXPECTED_SHARED_DATA_SIZE 548
+#define EXPECTED_SHARED_DATA_SIZE 964
 #endif // !EXPECTED_SHARED_DATA_SIZE
 
-namespace IPCFlags
-{
-    constexpr uint32_t IDLE = 0x0;           // État initial, au repos
-    constexpr uint32_t MASTER_READY = 0x1;   // Master a écrit les inputs, slave peut commencer
-    constexpr uint32_t SLAVE_STARTED = 0x2;  // Slave a lu les inputs et commence le traitement
-    constexpr uint32_t SLAVE_FINISHED = 0x4; // Slave a terminé et écrit les outputs
-}
-
 // Codes d'erreur
 namespace IPCErrorCode
 {
@@ -20,6 +13,9 @@ namespace IPCErrorCode
     constexpr int32_t START_GREATER_THAN_END = 1;
     constexpr int32_t OVERFLOW_ERROR = 2;
     constexpr int32_t FILE_WRITE_ERROR = 3;
+    constexpr int32_t STOPPED = 4;                  // arrêté à la demande du master, sumResult partiel
+    constexpr int32_t TIMEOUT_ERROR = 96;           // le slave n'a pas pris la requête ou s'est tu trop longtemps
+    constexpr int32_t INTEGRITY_ERROR = 97;         // message modifié ou incohérent (CRC32C / compteur)
     constexpr int32_t INVALID_RESPONSE_COUNTER = 98;
     constexpr int32_t UNKNOWN_ERROR = 99;
 }
@@ -28,32 +24,73 @@ namespace IPCErrorCode
 // supprime tout padding
 // garantit structure identique entre compilateurs
 
-struct SharedData
+// Job "somme" : inputs
+struct SumRequest
 {
-    // ### CHAMP ###   ### TAILLE ###   ### OFFSET ###
-
-    // Pour vérifier que le mapping est correct, lire une mémoire corrompue
-    uint32_t magic = 0xDEADBEEF;    // 4 bytes      Offset: 0
-    uint32_t version = 1;           // 4 bytes      Offset: 4
-
-    // Inputs
-    char resultsFolderPath[256];    // 256 bytes    Offset: 8
-    int32_t startNumber;            // 4 bytes      Offset: 264
-    int32_t endNumber;              // 4 bytes      Offset: 268
-
-    // Sécurité pour synchro req/res
-    uint32_t requestCounter;        // 4 bytes      Offset: 272
-    uint32_t responseCounter;       // 4 bytes      Offset: 276
+    // ### CHAMP ###   ### TAILLE ###   ### OFFSET (dans le bloc) ###
+    char resultsFolderPath[256];    // 256 bytes    Offset: 0
+    int32_t startNumber;            // 4 bytes      Offset: 256
+    int32_t endNumber;              // 4 bytes      Offset: 260
+};
 
-    // Outputs
-    char resultFileName[256];       // 256 bytes    Offset: 280
-    int32_t codeResult;             // 4 bytes      Offset: 536
-    int32_t sumResult;              // 4 bytes      Offset: 540
+// Job "somme" : outputs
+struct SumResponse
+{
+    char resultFileName[256];       // 256 bytes    Offset: 0
+    int32_t codeResult;             // 4 bytes      Offset: 256
+    int32_t sumResult;              // 4 bytes      Offset: 260
+};
+#pragma pack(pop)
 
-    uint32_t flags;                 // 4 bytes      Offset: 544
+template<>
+struct IpcFieldList<SumRequest>
+{
+    static constexpr IpcField fields[] = {
+        { "resultsFolderPath", offsetof(SumRequest, resultsFolderPath), 256, IpcFieldType::CString },
+        { "startNumber", offsetof(SumRequest, startNumber), 4, IpcFieldType::Int32 },
+        { "endNumber", offsetof(SumRequest, endNumber), 4, IpcFieldType::Int32 },
+    };
+};
 
-    // TOTAL                         548 bytes
+template<>
+struct IpcFieldList<SumResponse>
+{
+    static constexpr IpcField fields[] = {
+        { "resultFileName", offsetof(SumResponse, resultFileName), 256, IpcFieldType::CString },
+        { "codeResult", offsetof(SumResponse, codeResult), 4, IpcFieldType::Int32 },
+        { "sumResult", offsetof(SumResponse, sumResult), 4, IpcFieldType::Int32 },
+    };
 };
-#pragma pack(pop)
+
+// Segment complet
+//
+// ### CHAMP ###                        ### TAILLE ###   ### OFFSET ###
+// magic                                4 bytes          0
+// version                              4 bytes          4
+// request.resultsFolderPath            256 bytes        8
+// request.startNumber                  4 bytes          264
+// request.endNumber                    4 bytes          268
+// requestCounter                       4 bytes          272
+// responseCounter                      4 bytes          276
+// response.resultFileName              256 bytes        280
+// response.codeResult                  4 bytes          536
+// response.sumResult                   4 bytes          540
+// flags                                4 bytes          544
+// masterPid                            4 bytes          548
+// slavePid                             4 bytes          552
+// integrity                            4 bytes          556
+// requestCrc                           4 bytes          560
+// responseCrc                          4 bytes          564
+// partialHead                          4 bytes          568
+// control                              4 bytes          572
+// partials[16]                         16 x 24 bytes    576
+// slaveIntegrity                       4 bytes          960
+//
+// TOTAL                                964 bytes
+using SharedData = IpcSegment<SumRequest, SumResponse>;
+using SumChannel = IpcChannel<SumRequest, SumResponse>;
 
 static_assert(sizeof(SharedData) == EXPECTED_SHARED_DATA_SIZE, "SharedData size mismatch");
+static_assert(SumChannel::kOffsetRequest + offsetof(SumRequest, startNumber) == 264, "startNumber offset mismatch");
+static_assert(SumChannel::kOffsetResponse + offsetof(SumResponse, codeResult) == 536, "codeResult offset mismatch");
+static_assert(SumChannel::kOffsetFlags == 544, "flags offset mismatch");
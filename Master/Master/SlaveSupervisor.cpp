@@ -0,0 +1,415 @@
+#include "SlaveSupervisor.h"
+#include <QDebug>
+#include <QFileInfo>
+#include <QTimer>
+
+#include <iterator>
+
+#ifdef Q_OS_WIN
+#include <QWinEventNotifier>
+#include <tlhelp32.h>
+#endif
+
+// En dessous de cette durée de vie, on considère que le slave plante en boucle
+static constexpr qint64 MIN_UPTIME_MS = 1000;
+static constexpr int RESTART_BACKOFF_MS = 1000;       // doublé à chaque plantage rapproché
+static constexpr int MAX_RESTART_BACKOFF_MS = 30000;
+static constexpr int MAX_QUICK_RESTARTS = 8;
+
+// Lanceur (py.exe) -> redirecteur de venv -> interpréteur : quelques niveaux suffisent
+static constexpr int MAX_LAUNCHER_DEPTH = 4;
+
+SlaveSupervisor::SlaveSupervisor(QObject* parent) :
+	QObject(parent)
+{
+}
+
+SlaveSupervisor::~SlaveSupervisor()
+{
+	stop();
+}
+
+void SlaveSupervisor::start(const QString& program, const QStringList& arguments, const QStringList& channelNames,
+	const QVector<qint64>& livePids)
+{
+	stop();
+
+	m_program = program;
+	m_arguments = arguments;
+
+	m_slots.resize(channelNames.size());
+	for (int i = 0; i < channelNames.size(); ++i)
+	{
+		m_slots[i].channelName = channelNames[i];
+
+		const qint64 livePid = i < livePids.size() ? livePids[i] : -1;
+		if (livePid > 0 && adopt(i, livePid, true))
+			continue;
+
+		launch(i);
+	}
+}
+
+void SlaveSupervisor::stop()
+{
+	for (Slot& slot : m_slots)
+		stopSlot(slot);
+	m_slots.clear();
+}
+
+void SlaveSupervisor::stopSlot(Slot& slot)
+{
+#ifdef Q_OS_WIN
+	if (slot.adoptedHandle && slot.adoptedOwned)
+		TerminateProcess(slot.adoptedHandle, 1);
+#endif
+	releaseAdopted(slot);
+
+	if (!slot.process)
+		return;
+
+	slot.stopping = true;
+	slot.process->disconnect(this);
+	slot.process->kill();
+	slot.process->waitForFinished(1000);
+	delete slot.process;
+	slot.process = nullptr;
+}
+
+void SlaveSupervisor::detach()
+{
+	for (Slot& slot : m_slots)
+	{
+		releaseAdopted(slot);
+
+		if (!slot.process)
+			continue;
+
+		// Un QProcess détruit tue son process : on l'oublie sans le détruire
+		slot.stopping = true;
+		slot.process->disconnect(this);
+		slot.process->setParent(nullptr);
+		slot.process = nullptr;
+	}
+	m_slots.clear();
+}
+
+bool SlaveSupervisor::isRunning(int slot) const
+{
+	if (slot < 0 || slot >= m_slots.size())
+		return false;
+
+	if (m_slots[slot].adoptedPid > 0)
+		return true;
+
+	return m_slots[slot].process && m_slots[slot].process->state() == QProcess::Running;
+}
+
+qint64 SlaveSupervisor::pid(int slot) const
+{
+	if (!isRunning(slot))
+		return -1;
+
+	if (m_slots[slot].adoptedPid > 0)
+		return m_slots[slot].adoptedPid;
+
+	return m_slots[slot].process->processId();
+}
+
+int SlaveSupervisor::findRunningSlot(int exclude) const
+{
+	for (int i = 0; i < m_slots.size(); ++i)
+	{
+		if (i != exclude && isRunning(i))
+			return i;
+	}
+	return -1;
+}
+
+void SlaveSupervisor::restart(int slot)
+{
+	if (slot < 0 || slot >= m_slots.size())
+		return;
+
+	Slot& s = m_slots[slot];
+	if (s.lastStart.isValid() && s.lastStart.elapsed() < MIN_UPTIME_MS)
+		s.quickRestarts++;
+	else
+		s.quickRestarts = 0;
+
+	if (s.quickRestarts >= MAX_QUICK_RESTARTS)
+	{
+		qDebug() << "Supervisor: slot" << slot << "crashed" << s.quickRestarts << "times in a row, giving up";
+		s.failed = true;
+		emit slaveFailed(slot);
+		return;
+	}
+
+	if (s.quickRestarts > 0)
+	{
+		const int delay = qMin(RESTART_BACKOFF_MS << (s.quickRestarts - 1), MAX_RESTART_BACKOFF_MS);
+		qDebug() << "Supervisor: slot" << slot << "crashing repeatedly, restart delayed by" << delay << "ms";
+		QTimer::singleShot(delay, this, [this, slot]() { launch(slot); });
+		return;
+	}
+
+	launch(slot);
+}
+
+bool SlaveSupervisor::kill(int slot)
+{
+	if (slot < 0 || slot >= m_slots.size())
+		return false;
+
+	Slot& s = m_slots[slot];
+	qDebug() << "Supervisor: killing unresponsive slave on slot" << slot;
+
+#ifdef Q_OS_WIN
+	if (s.adoptedHandle)
+		return s.adoptedOwned && TerminateProcess(s.adoptedHandle, 1);
+#endif
+	if (!s.process || s.process->state() == QProcess::NotRunning)
+		return false;
+
+	s.process->kill();
+	return true;
+}
+
+bool SlaveSupervisor::hasFailed(int slot) const
+{
+	return slot >= 0 && slot < m_slots.size() && m_slots[slot].failed;
+}
+
+bool SlaveSupervisor::isOwnSlave(int slot, qint64 pid) const
+{
+	const qint64 own = this->pid(slot);
+	if (own <= 0 || pid <= 0)
+		return false;
+	if (pid == own)
+		return true;
+
+#ifdef Q_OS_WIN
+	DWORD current = static_cast<DWORD>(pid);
+	for (int depth = 0; depth < MAX_LAUNCHER_DEPTH; ++depth)
+	{
+		current = parentPid(current);
+		if (current == 0)
+			return false;
+		if (current == static_cast<DWORD>(own))
+			return true;
+	}
+#endif
+	return false;
+}
+
+bool SlaveSupervisor::yieldTo(int slot, qint64 pid)
+{
+	if (slot < 0 || slot >= m_slots.size() || pid <= 0 || isOwnSlave(slot, pid) || !isAlive(pid))
+		return false;
+
+	qDebug() << "Supervisor: channel" << m_slots[slot].channelName << "is served by slave" << pid
+		<< "started outside the master, stopping ours";
+
+	stopSlot(m_slots[slot]);
+	m_slots[slot].stopping = false;
+	if (adopt(slot, pid, false))
+		return true;
+
+	// Parti entre-temps : on reprend le canal
+	launch(slot);
+	return false;
+}
+
+void SlaveSupervisor::launch(int slot)
+{
+	if (slot < 0 || slot >= m_slots.size())
+		return;
+
+	Slot& s = m_slots[slot];
+	if (s.adoptedPid > 0 || s.failed)
+		return;     // relance différée devenue sans objet (slot cédé ou abandonné)
+
+	if (s.process)
+	{
+		s.process->disconnect(this);
+		s.process->deleteLater();
+	}
+
+	s.stopping = false;
+	s.process = new QProcess(this);
+	s.process->setProcessChannelMode(QProcess::ForwardedChannels);
+
+	// QProcess::finished / errorOccurred arrivent dès la mort du process :
+	// la détection ne dépend d'aucun timeout
+	connect(s.process, &QProcess::started, this, [this, slot]() { emit slaveStarted(slot); });
+	connect(s.process, &QProcess::finished, this, [this, slot]() { onProcessExited(slot); });
+	connect(s.process, &QProcess::errorOccurred, this, [this, slot](QProcess::ProcessError error)
+	{
+		if (error == QProcess::FailedToStart)
+			onProcessExited(slot);
+	});
+
+	QStringList arguments = m_arguments;
+	arguments << "--shm" << s.channelName;
+
+	s.lastStart.start();
+	s.process->start(m_program, arguments);
+
+	qDebug() << "Supervisor: launching slot" << slot << m_program << arguments;
+}
+
+bool SlaveSupervisor::adopt(int slot, qint64 pid, bool owned)
+{
+#ifdef Q_OS_WIN
+	HANDLE handle = OpenProcess(SYNCHRONIZE | PROCESS_QUERY_LIMITED_INFORMATION | PROCESS_TERMINATE, FALSE, static_cast<DWORD>(pid));
+	if (handle == nullptr)
+		return false;
+
+	// Pid recyclé par un process déjà terminé
+	if (WaitForSingleObject(handle, 0) != WAIT_TIMEOUT)
+	{
+		CloseHandle(handle);
+		return false;
+	}
+
+	// Pid lu dans un segment repris : il peut désigner un process sans rapport qui a recyclé
+	// le pid du slave mort. On ne s'engage à le tuer que si c'est bien notre commande
+	if (owned && !runsProgram(handle))
+	{
+		qDebug() << "Supervisor: pid" << pid << "on slot" << slot << "is not a" << m_program << "process, not adopting it";
+		CloseHandle(handle);
+		return false;
+	}
+
+	Slot& s = m_slots[slot];
+	s.adoptedPid = pid;
+	s.adoptedOwned = owned;
+	s.adoptedHandle = handle;
+	s.adoptedNotifier = new QWinEventNotifier(handle, this);
+	connect(s.adoptedNotifier, &QWinEventNotifier::activated, this, [this, slot]()
+	{
+		releaseAdopted(m_slots[slot]);
+		onProcessExited(slot);
+	});
+
+	qDebug() << "Supervisor: adopted live slave" << pid << "on slot" << slot << (owned ? "" : "(not started by the master)");
+	return true;
+#else
+	Q_UNUSED(slot);
+	Q_UNUSED(pid);
+	Q_UNUSED(owned);
+	return false;
+#endif
+}
+
+#ifdef Q_OS_WIN
+bool SlaveSupervisor::runsProgram(HANDLE handle) const
+{
+	wchar_t path[MAX_PATH * 2];
+	DWORD length = static_cast<DWORD>(std::size(path));
+	if (!QueryFullProcessImageNameW(handle, 0, path, &length))
+		return false;
+
+	const QFileInfo image(QString::fromWCharArray(path, static_cast<int>(length)));
+	const QFileInfo program(m_program);
+
+	// Slave natif : même exécutable. Script : "python" résolu par le PATH, on ne connaît
+	// que le nom de l'interpréteur (python.exe, python3.12.exe...)
+	if (program.isAbsolute())
+		return image.absoluteFilePath().compare(program.absoluteFilePath(), Qt::CaseInsensitive) == 0;
+
+	return image.completeBaseName().startsWith(program.completeBaseName(), Qt::CaseInsensitive);
+}
+#endif
+
+bool SlaveSupervisor::isAlive(qint64 pid)
+{
+#ifdef Q_OS_WIN
+	HANDLE handle = OpenProcess(SYNCHRONIZE, FALSE, static_cast<DWORD>(pid));
+	if (handle == nullptr)
+		return false;
+
+	const bool alive = WaitForSingleObject(handle, 0) == WAIT_TIMEOUT;
+	CloseHandle(handle);
+	return alive;
+#else
+	Q_UNUSED(pid);
+	return false;
+#endif
+}
+
+#ifdef Q_OS_WIN
+DWORD SlaveSupervisor::parentPid(DWORD pid)
+{
+	HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
+	if (snapshot == INVALID_HANDLE_VALUE)
+		return 0;
+
+	DWORD parent = 0;
+	PROCESSENTRY32W entry{};
+	entry.dwSize = sizeof(entry);
+	for (BOOL ok = Process32FirstW(snapshot, &entry); ok; ok = Process32NextW(snapshot, &entry))
+	{
+		if (entry.th32ProcessID == pid)
+		{
+			parent = entry.th32ParentProcessID;
+			break;
+		}
+	}
+	CloseHandle(snapshot);
+
+	if (parent == 0)
+		return 0;
+
+	// Le pid d'un parent mort peut avoir été repris : le vrai parent est né avant son enfant
+	auto creationTime = [](DWORD id, ULARGE_INTEGER& out)
+	{
+		HANDLE handle = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, id);
+		if (handle == nullptr)
+			return false;
+
+		FILETIME created, exited, kernel, user;
+		const bool ok = GetProcessTimes(handle, &created, &exited, &kernel, &user);
+		CloseHandle(handle);
+		out.LowPart = created.dwLowDateTime;
+		out.HighPart = created.dwHighDateTime;
+		return ok;
+	};
+
+	ULARGE_INTEGER childCreated, parentCreated;
+	if (!creationTime(pid, childCreated) || !creationTime(parent, parentCreated) ||
+		parentCreated.QuadPart > childCreated.QuadPart)
+		return 0;
+
+	return parent;
+}
+#endif
+
+void SlaveSupervisor::releaseAdopted(Slot& slot)
+{
+#ifdef Q_OS_WIN
+	if (slot.adoptedNotifier)
+	{
+		slot.adoptedNotifier->setEnabled(false);
+		slot.adoptedNotifier->deleteLater();
+		slot.adoptedNotifier = nullptr;
+	}
+	if (slot.adoptedHandle)
+	{
+		CloseHandle(slot.adoptedHandle);
+		slot.adoptedHandle = nullptr;
+	}
+#endif
+	slot.adoptedPid = -1;
+	slot.adoptedOwned = false;
+}
+
+void SlaveSupervisor::onProcessExited(int slot)
+{
+	Slot& s = m_slots[slot];
+	if (s.stopping)
+		return;
+
+	qDebug() << "Supervisor: slave on slot" << slot << "exited, code" << (s.process ? s.process->exitCode() : -1);
+	emit slaveExited(slot);
+}
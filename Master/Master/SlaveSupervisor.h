@@ -0,0 +1,106 @@
+#pragma once
+
+#include <QObject>
+#include <QProcess>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QElapsedTimer>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#endif
+
+class QWinEventNotifier;
+
+// Lance et surveille un slave par canal de mémoire partagée
+// Un seul canal est actif à la fois, les autres sont des slaves de secours
+// déjà démarrés (interpréteur chargé, mapping ouvert) prêts à prendre le relais
+class SlaveSupervisor : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SlaveSupervisor(QObject* parent = nullptr);
+    ~SlaveSupervisor() override;
+
+    // Chaque slave reçoit "--shm <nom du canal>" en plus des arguments
+    // livePids : slaves déjà attachés (master relancé), adoptés au lieu d'être relancés
+    // s'ils exécutent bien program ; un pid recyclé par un autre process est ignoré
+    void start(const QString& program, const QStringList& arguments, const QStringList& channelNames,
+        const QVector<qint64>& livePids = {});
+    void stop();
+
+    // Laisse les slaves tourner (requête en cours reprise par le prochain master)
+    void detach();
+
+    int slotCount() const { return m_slots.size(); }
+    bool isRunning(int slot) const;
+    qint64 pid(int slot) const;
+
+    // Premier slot vivant autre que exclude, -1 si aucun
+    int findRunningSlot(int exclude = -1) const;
+
+    // Relance le slave d'un slot, avec un délai croissant s'il plante en boucle
+    // Après MAX_QUICK_RESTARTS plantages rapprochés, le slot est abandonné (slaveFailed)
+    void restart(int slot);
+    bool hasFailed(int slot) const;
+
+    // Tue le slave d'un slot qui ne répond plus ; sa sortie suit le chemin habituel (slaveExited)
+    // Un slave lancé hors du master n'est jamais tué
+    // Renvoie true si un slaveExited va suivre
+    bool kill(int slot);
+
+    // pid est le slave du slot ou l'un de ses descendants : avec py.exe ou le lanceur d'un venv,
+    // l'interpréteur qui écrit son pid dans le segment est un petit-enfant du process lancé
+    bool isOwnSlave(int slot, qint64 pid) const;
+
+    // Slave lancé hors du master sur le canal d'un slot : le nôtre s'efface et on surveille
+    // le sien, sans jamais le tuer. false si pid n'est pas un autre process vivant
+    bool yieldTo(int slot, qint64 pid);
+
+signals:
+    void slaveStarted(int slot);
+    void slaveExited(int slot);
+    void slaveFailed(int slot);
+
+private:
+    struct Slot
+    {
+        QProcess* process = nullptr;
+        QString channelName;
+
+        // Slave hérité d'un master précédent : pas de QProcess, on surveille son handle
+        // adoptedOwned = false : slave lancé à la main, jamais tué par le master
+        qint64 adoptedPid = -1;
+        bool adoptedOwned = false;
+        QWinEventNotifier* adoptedNotifier = nullptr;
+#ifdef Q_OS_WIN
+        HANDLE adoptedHandle = nullptr;
+#endif
+
+        QElapsedTimer lastStart;
+        int quickRestarts = 0;      // plantages consécutifs avant MIN_UPTIME_MS
+        bool failed = false;
+        bool stopping = false;
+    };
+
+    void launch(int slot);
+    // owned : le process doit exécuter m_program (cf. runsProgram), sinon il n'est pas adopté
+    bool adopt(int slot, qint64 pid, bool owned);
+#ifdef Q_OS_WIN
+    bool runsProgram(HANDLE handle) const;
+#endif
+    void stopSlot(Slot& slot);
+    void releaseAdopted(Slot& slot);
+    static bool isAlive(qint64 pid);
+#ifdef Q_OS_WIN
+    // Parent de pid, 0 si inconnu ; un parent démarré après pid a recyclé le pid du vrai parent
+    static DWORD parentPid(DWORD pid);
+#endif
+    void onProcessExited(int slot);
+
+    QString m_program;
+    QStringList m_arguments;
+    QVector<Slot> m_slots;
+};
@@ -0,0 +1,176 @@
+#include "SocketTransport.h"
+#include <QDebug>
+
+SocketTransport::SocketTransport(const std::string& channelName) :
+	m_path(IpcSocket::pathFor(channelName)),
+	m_channel(m_mirror)
+{
+	m_channel.initialize();
+}
+
+bool SocketTransport::listen()
+{
+	if (!m_listener.listen(m_path))
+	{
+		qDebug() << "Socket transport unavailable on" << QString::fromStdString(m_path);
+		return false;
+	}
+	return true;
+}
+
+bool SocketTransport::isConnected()
+{
+	if (!m_connection.isOpen())
+		acceptPending(0);
+	else
+		readAvailable();
+	return m_connection.isOpen();
+}
+
+void SocketTransport::postRequest(const SumRequest& request, uint32_t requestCounter, uint32_t integrity)
+{
+	m_channel.postRequest(request, requestCounter, integrity);
+
+	// Sans slave connecté, la requête part à la prochaine connexion (cf. acceptPending)
+	std::lock_guard<std::mutex> lock(m_connectionMutex);
+	if (m_connection.isOpen() && !sendRequest())
+		dropConnection();
+}
+
+void SocketTransport::requestStop()
+{
+	m_channel.requestStop();
+
+	std::lock_guard<std::mutex> lock(m_connectionMutex);
+	if (m_connection.isOpen() && !m_connection.sendFrame(IPCFrame::STOP, m_channel.requestCounter()))
+		dropConnection();
+}
+
+void SocketTransport::pump(int timeoutMs)
+{
+	if (!m_connection.isOpen())
+	{
+		acceptPending(timeoutMs);
+		return;
+	}
+
+	// Attente hors verrou : requestStop() ne doit pas attendre la fin du délai
+	if (!m_connection.waitReadable(timeoutMs))
+		return;
+
+	readAvailable();
+}
+
+void SocketTransport::readAvailable()
+{
+	// Vider ce qui est arrivé (rafale de résultats partiels) sans rendre la main entre deux trames
+	IpcFrameHeader header;
+	uint8_t payload[IPCFrame::MAX_PAYLOAD];
+
+	for (;;)
+	{
+		IpcSocket::Result result;
+		{
+			std::lock_guard<std::mutex> lock(m_connectionMutex);
+			result = m_connection.receiveFrame(header, payload, sizeof(payload), 0);
+		}
+
+		if (result == IpcSocket::Result::Timeout)
+			return;
+
+		if (result == IpcSocket::Result::Closed)
+		{
+			// Fin de flux, ECONNRESET ou trame invalide : receiveFrame a fermé le socket et
+			// une trame incomplète n'est jamais appliquée. Le superviseur gère la mort du slave
+			qDebug() << "Socket transport: slave disconnected from" << QString::fromStdString(m_path);
+			std::lock_guard<std::mutex> lock(m_connectionMutex);
+			dropConnection();
+			return;
+		}
+
+		apply(header, payload);
+	}
+}
+
+void SocketTransport::acceptPending(int timeoutMs)
+{
+	std::lock_guard<std::mutex> lock(m_connectionMutex);
+	if (!m_listener.accept(m_connection, timeoutMs))
+		return;
+
+	qDebug() << "Socket transport: slave connected on" << QString::fromStdString(m_path);
+
+	// Requête publiée avant la connexion du slave
+	if (m_channel.flags() == IPCFlags::MASTER_READY && !sendRequest())
+		dropConnection();
+}
+
+void SocketTransport::apply(const IpcFrameHeader& header, const uint8_t* payload)
+{
+	SharedData* segment = m_channel.segment();
+
+	// Trame d'une requête précédente (abandonnée, ou arrivée après un timeout) : ignorée
+	const bool current = header.counter == m_channel.requestCounter();
+	if (!current && (header.type == IPCFrame::STARTED || header.type == IPCFrame::PARTIAL || header.type == IPCFrame::RESPONSE))
+	{
+		qDebug() << "Socket transport: dropping frame" << header.type << "for request" << header.counter
+			<< ", in flight" << m_channel.requestCounter();
+		return;
+	}
+
+	switch (header.type)
+	{
+	case IPCFrame::HELLO:
+		if (header.length == sizeof(uint32_t))
+		{
+			uint32_t pid = 0;
+			memcpy(&pid, payload, sizeof(pid));
+			m_slavePid = pid;
+			m_channel.setSlavePid(pid);
+			m_channel.setSlaveIntegrity(header.aux);
+		}
+		break;
+
+	case IPCFrame::STARTED:
+		m_channel.acceptRequest(header.counter);
+		break;
+
+	case IPCFrame::PARTIAL:
+		if (header.length == sizeof(IpcPartial))
+		{
+			IpcPartial partial;
+			memcpy(&partial, payload, sizeof(partial));
+			m_channel.publishPartial(partial.position, partial.value);
+		}
+		break;
+
+	case IPCFrame::RESPONSE:
+		if (header.length == sizeof(SumResponse))
+		{
+			// CRC du slave recopié tel quel : readResponse() le vérifie de bout en bout
+			memcpy(&segment->response, payload, sizeof(SumResponse));
+			segment->responseCounter = header.counter;
+			segment->responseCrc = header.crc;
+			m_channel.setFlags(IPCFlags::SLAVE_FINISHED);
+		}
+		break;
+
+	default:
+		qDebug() << "Socket transport: unexpected frame type" << header.type;
+		break;
+	}
+}
+
+bool SocketTransport::sendRequest()
+{
+	const SharedData* segment = m_channel.segment();
+	return m_connection.sendFrame(IPCFrame::REQUEST, segment->requestCounter, segment->integrity,
+		segment->requestCrc, &segment->request, sizeof(SumRequest));
+}
+
+void SocketTransport::dropConnection()
+{
+	m_connection.close();
+	m_slavePid = 0;
+	m_channel.setSlaveIntegrity(IPCIntegrity::NONE);
+}
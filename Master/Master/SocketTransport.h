@@ -0,0 +1,56 @@
+#pragma once
+#include "IpcSocket.h"
+#include "SharedData.h"
+
+#include <atomic>
+#include <mutex>
+#include <string>
+
+// Transport d'un canal par socket Unix, alternative à la mémoire partagée
+// Le master reste écrit contre SumChannel : les trames du slave sont rejouées dans
+// un segment local (le miroir) que le WorkerThread lit comme le segment partagé.
+// Le slave n'est plus interrogé en boucle : il peut dormir sur son socket
+//
+// Threads : pump() et postRequest() depuis le worker en cours, isConnected() depuis
+// le thread du modèle quand aucun worker ne tourne, requestStop() depuis n'importe où
+class SocketTransport
+{
+public:
+    explicit SocketTransport(const std::string& channelName);
+
+    // Crée le socket en écoute (le slave s'y connecte de lui-même)
+    bool listen();
+    const std::string& path() const { return m_path; }
+
+    // Accepte sans attendre un slave en attente de connexion
+    // Sur une connexion ouverte, lit ce qui est arrivé : une fin de flux (slave mort
+    // pendant qu'aucun worker ne lisait) ferme la connexion
+    bool isConnected();
+    uint32_t slavePid() const { return m_slavePid; }
+
+    // Segment local à passer à SumChannel
+    void* mirror() { return m_mirror; }
+
+    // Publie la requête dans le miroir et l'envoie au slave (renvoyée à la connexion s'il n'y en a pas)
+    void postRequest(const SumRequest& request, uint32_t requestCounter, uint32_t integrity);
+    void requestStop();
+
+    // Attend au plus timeoutMs des trames du slave et les applique au miroir
+    void pump(int timeoutMs);
+
+private:
+    void acceptPending(int timeoutMs);
+    void readAvailable();
+    void apply(const IpcFrameHeader& header, const uint8_t* payload);
+    bool sendRequest();
+    void dropConnection();
+
+    std::string m_path;
+    IpcSocket m_listener;
+    IpcSocket m_connection;
+    std::mutex m_connectionMutex;   // ouverture, fermeture et envoi sur m_connection
+    std::atomic<uint32_t> m_slavePid{ 0 };
+
+    alignas(8) uint8_t m_mirror[SumChannel::kSize];
+    SumChannel m_channel;
+};
@@ -0,0 +1,258 @@
+#include "SweepRunner.h"
+#include "AppModel.h"
+#include <QDebug>
+#include <QFile>
+#include <QTextStream>
+
+// Requêtes soumises d'avance, bornées par la capacité de la file du modèle
+static constexpr int MAX_IN_FLIGHT = 8;
+
+// File occupée par d'autres : nouvel essai toutes les RETRY_DELAY_MS, abandon après MAX_REJECTIONS
+static constexpr int RETRY_DELAY_MS = 200;
+static constexpr int MAX_REJECTIONS = 50;
+
+// Échantillons réservés d'avance, le reste grandit à la demande
+static constexpr int MAX_RESERVED_SAMPLES = 65536;
+
+SweepRunner::SweepRunner(AppModel* model, QObject* parent) :
+	QObject(parent),
+	m_model(model)
+{
+	connect(m_model, &AppModel::requestCompleted, this, &SweepRunner::onRequestCompleted);
+	connect(m_model, &AppModel::requestDropped, this, &SweepRunner::onRequestDropped);
+
+	m_retryTimer.setSingleShot(true);
+	m_retryTimer.setInterval(RETRY_DELAY_MS);
+	connect(&m_retryTimer, &QTimer::timeout, this, &SweepRunner::fillWindow);
+}
+
+bool SweepRunner::parseRanges(const QString& spec, QVector<Range>& out, QString& error)
+{
+	out.clear();
+
+	const QStringList lines = spec.split('\n');
+	for (int lineNo = 0; lineNo < lines.size(); ++lineNo)
+	{
+		const QString line = lines[lineNo].trimmed();
+		if (line.isEmpty() || line.startsWith('#'))
+			continue;
+
+		const QStringList parts = line.split(' ', Qt::SkipEmptyParts);
+
+		QVector<int> values;
+		bool ok = true;
+		const bool grid = parts[0].compare("grid", Qt::CaseInsensitive) == 0;
+		for (int i = grid ? 1 : 0; i < parts.size() && ok; ++i)
+			values << parts[i].toInt(&ok);
+
+		if (!ok)
+		{
+			error = QString("Line %1: not a number").arg(lineNo + 1);
+			return false;
+		}
+
+		if (grid)
+		{
+			// grid start endFrom endTo steps : même début, fin répartie linéairement
+			if (values.size() != 4 || values[3] < 1)
+			{
+				error = QString("Line %1: expected 'grid start endFrom endTo steps'").arg(lineNo + 1);
+				return false;
+			}
+			if (values[3] > MAX_POINTS - out.size())
+			{
+				error = QString("Line %1: too many steps, at most %2 ranges per sweep").arg(lineNo + 1).arg(MAX_POINTS);
+				return false;
+			}
+
+			const int start = values[0];
+			const qint64 from = values[1];
+			const qint64 to = values[2];
+			const int steps = values[3];
+			for (int i = 0; i < steps; ++i)
+			{
+				const qint64 end = steps == 1 ? from : from + (to - from) * i / (steps - 1);
+				out.append({ start, static_cast<int>(end) });
+			}
+		}
+		else
+		{
+			if (values.size() != 2)
+			{
+				error = QString("Line %1: expected 'start end'").arg(lineNo + 1);
+				return false;
+			}
+			if (out.size() >= MAX_POINTS)
+			{
+				error = QString("Line %1: at most %2 ranges per sweep").arg(lineNo + 1).arg(MAX_POINTS);
+				return false;
+			}
+			out.append({ values[0], values[1] });
+		}
+	}
+
+	if (out.isEmpty())
+	{
+		error = "No range defined";
+		return false;
+	}
+	return true;
+}
+
+void SweepRunner::run(const QVector<SweepRunner::Range>& ranges, int repeat)
+{
+	stop();
+
+	m_ranges = ranges;
+	m_repeat = qMax(1, repeat);
+	m_nextJob = 0;
+	m_totalJobs = m_ranges.size() * m_repeat;
+	m_doneJobs = 0;
+	m_rejections = 0;
+	m_samples.clear();
+	m_samples.reserve(qMin(m_totalJobs, MAX_RESERVED_SAMPLES));
+	m_running = true;
+	m_clock.start();
+
+	emit progressChanged(0, m_totalJobs);
+	fillWindow();
+}
+
+void SweepRunner::stop()
+{
+	m_running = false;
+	m_retryTimer.stop();
+
+	// Les requêtes encore en file sont retirées ; celle que le slave traite ira à son terme,
+	// son résultat est ignoré
+	const QList<quint64> ids = m_pending.keys();
+	m_pending.clear();
+	for (quint64 id : ids)
+		m_model->cancel(id);
+}
+
+void SweepRunner::fail(const QString& error)
+{
+	qDebug() << "Sweep failed:" << error;
+	stop();
+	emit failed(error);
+	emit finished();
+}
+
+void SweepRunner::fillWindow()
+{
+	const int window = qMin(MAX_IN_FLIGHT, m_model->queueCapacity());
+
+	while (m_running && m_nextJob < m_totalJobs && m_pending.size() < window)
+	{
+		const int rangeIndex = m_nextJob / m_repeat;
+		const int rep = m_nextJob % m_repeat;
+		const Range& range = m_ranges[rangeIndex];
+
+		Pending pending;
+		pending.rangeIndex = rangeIndex;
+		pending.repeat = rep;
+		pending.submitted.start();
+
+		const quint64 id = m_model->submit(range.start, range.end);
+		if (id == 0)
+		{
+			// Un de nos résultats relancera fillWindow ; sinon seul un nouvel essai le fera
+			if (m_pending.isEmpty())
+			{
+				if (++m_rejections >= MAX_REJECTIONS)
+				{
+					fail(QString("Request queue full, %1 submissions rejected").arg(m_rejections));
+					return;
+				}
+				m_retryTimer.start();
+			}
+			break;
+		}
+
+		m_rejections = 0;
+		m_pending.insert(id, pending);
+		m_nextJob++;
+	}
+}
+
+void SweepRunner::onRequestCompleted(quint64 id, int errorCode, int sumResult, quint64 masterElapsed, quint64 slaveElapsed)
+{
+	auto it = m_pending.find(id);
+	if (it == m_pending.end())
+		return;
+
+	const Range& range = m_ranges[it->rangeIndex];
+
+	Sample sample;
+	sample.index = m_samples.size();
+	sample.start = range.start;
+	sample.end = range.end;
+	sample.repeat = it->repeat;
+	sample.errorCode = errorCode;
+	sample.sumResult = sumResult;
+	sample.e2eMs = it->submitted.nsecsElapsed() / 1e6;
+	sample.masterMs = masterElapsed;
+	sample.slaveMs = slaveElapsed;
+
+	m_pending.erase(it);
+	m_doneJobs++;
+
+	const double seconds = m_clock.nsecsElapsed() / 1e9;
+	sample.throughput = seconds > 0 ? m_doneJobs / seconds : 0;
+
+	m_samples.append(sample);
+	emit sampleAdded(sample);
+	emit progressChanged(m_doneJobs, m_totalJobs);
+
+	fillWindow();
+	finishIfDone();
+}
+
+void SweepRunner::onRequestDropped(quint64 id)
+{
+	if (m_pending.remove(id) == 0)
+		return;
+
+	// Point perdu : compté comme fait pour que le balayage se termine
+	m_doneJobs++;
+	emit progressChanged(m_doneJobs, m_totalJobs);
+
+	fillWindow();
+	finishIfDone();
+}
+
+void SweepRunner::finishIfDone()
+{
+	if (!m_running || m_doneJobs < m_totalJobs)
+		return;
+
+	m_running = false;
+	emit finished();
+}
+
+bool SweepRunner::exportCsv(const QString& path, QString& error) const
+{
+	QFile file(path);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+	{
+		error = file.errorString();
+		return false;
+	}
+
+	QTextStream out(&file);
+	out << "index,start,end,size,repeat,code,sum,e2e_ms,master_ms,slave_ms,ipc_overhead_ms,throughput_rps\n";
+
+	for (const Sample& s : m_samples)
+	{
+		const qint64 size = static_cast<qint64>(s.end) - s.start + 1;
+		const qint64 overhead = static_cast<qint64>(s.masterMs) - static_cast<qint64>(s.slaveMs);
+
+		out << s.index << ',' << s.start << ',' << s.end << ',' << size << ',' << s.repeat << ','
+			<< s.errorCode << ',' << s.sumResult << ',' << QString::number(s.e2eMs, 'f', 3) << ','
+			<< s.masterMs << ',' << s.slaveMs << ',' << overhead << ','
+			<< QString::number(s.throughput, 'f', 2) << '\n';
+	}
+
+	return true;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QString>
+#include <QTimer>
+#include <QVector>
+
+class AppModel;
+
+// Balayage de plages : chaque point est soumis "repeat" fois au modèle,
+// en gardant quelques requêtes d'avance dans la file pour que le slave
+// enchaîne sans attendre le thread UI
+class SweepRunner : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Range
+    {
+        int start = 0;
+        int end = 0;
+    };
+
+    struct Sample
+    {
+        int index = 0;          // ordre de complétion
+        int start = 0;
+        int end = 0;
+        int repeat = 0;
+        int errorCode = 0;
+        int sumResult = 0;
+        double e2eMs = 0;       // soumission -> résultat, file d'attente comprise
+        quint64 masterMs = 0;
+        quint64 slaveMs = 0;
+        double throughput = 0;  // requêtes/s cumulées depuis le début du balayage
+    };
+
+    explicit SweepRunner(AppModel* model, QObject* parent = nullptr);
+
+    // Une ligne par entrée :
+    //     start end
+    //     grid start endFrom endTo steps
+    // Au plus MAX_POINTS plages au total
+    // Renvoie false et remplit error si une ligne est invalide
+    static constexpr int MAX_POINTS = 10000;
+    static bool parseRanges(const QString& spec, QVector<Range>& out, QString& error);
+
+    bool isRunning() const { return m_running; }
+    int doneJobs() const { return m_doneJobs; }
+    int totalJobs() const { return m_totalJobs; }
+    const QVector<Sample>& samples() const { return m_samples; }
+
+    bool exportCsv(const QString& path, QString& error) const;
+
+public slots:
+    void run(const QVector<SweepRunner::Range>& ranges, int repeat);
+    void stop();
+
+signals:
+    void sampleAdded(const SweepRunner::Sample& sample);
+    void progressChanged(int done, int total);
+    void finished();
+    // Balayage abandonné : le modèle refuse toutes ses requêtes
+    void failed(const QString& error);
+
+private slots:
+    void onRequestCompleted(quint64 id, int errorCode, int sumResult, quint64 masterElapsed, quint64 slaveElapsed);
+    void onRequestDropped(quint64 id);
+
+private:
+    struct Pending
+    {
+        int rangeIndex = 0;
+        int repeat = 0;
+        QElapsedTimer submitted;
+    };
+
+    void fillWindow();
+    void finishIfDone();
+    void fail(const QString& error);
+
+    AppModel* m_model;
+
+    QVector<Range> m_ranges;
+    int m_repeat = 1;
+    int m_nextJob = 0;          // index "à plat" : rangeIndex * repeat + rep
+    int m_totalJobs = 0;
+    int m_doneJobs = 0;
+    bool m_running = false;
+
+    // File pleine sans requête du balayage en cours : rien ne relancera fillWindow, on réessaie
+    QTimer m_retryTimer;
+    int m_rejections = 0;       // refus consécutifs
+
+    QHash<quint64, Pending> m_pending;
+    QVector<Sample> m_samples;
+    QElapsedTimer m_clock;
+};
@@ -0,0 +1,87 @@
+#include "ThroughputChart.h"
+#include <QPainter>
+#include <QPainterPath>
+
+ThroughputChart::ThroughputChart(QWidget* parent) :
+	QWidget(parent)
+{
+	setMinimumHeight(120);
+}
+
+void ThroughputChart::clear()
+{
+	m_masterMs.clear();
+	m_slaveMs.clear();
+	m_throughput.clear();
+	m_maxLatency = 1;
+	m_maxThroughput = 1;
+	update();
+}
+
+void ThroughputChart::addPoint(double masterMs, double slaveMs, double throughput)
+{
+	m_masterMs.append(masterMs);
+	m_slaveMs.append(slaveMs);
+	m_throughput.append(throughput);
+	m_maxLatency = qMax(m_maxLatency, qMax(masterMs, slaveMs));
+	m_maxThroughput = qMax(m_maxThroughput, throughput);
+	update();
+}
+
+void ThroughputChart::paintEvent(QPaintEvent* event)
+{
+	Q_UNUSED(event);
+
+	QPainter painter(this);
+	painter.setRenderHint(QPainter::Antialiasing);
+	painter.fillRect(rect(), palette().base());
+
+	const int margin = 40;
+	const QRectF plot = QRectF(rect()).adjusted(margin, 10, -margin, -20);
+	if (plot.width() <= 0 || plot.height() <= 0)
+		return;
+
+	painter.setPen(palette().color(QPalette::Mid));
+	painter.drawRect(plot);
+
+	// Graduations des deux axes
+	painter.setPen(palette().color(QPalette::Text));
+	painter.drawText(QRectF(0, plot.top(), margin - 4, 14), Qt::AlignRight, QString::number(m_maxLatency, 'f', 0));
+	painter.drawText(QRectF(0, plot.bottom() - 14, margin - 4, 14), Qt::AlignRight, "0 ms");
+	painter.drawText(QRectF(plot.right() + 4, plot.top(), margin - 4, 14), Qt::AlignLeft, QString::number(m_maxThroughput, 'f', 0));
+	painter.drawText(QRectF(plot.right() + 4, plot.bottom() - 14, margin - 4, 14), Qt::AlignLeft, "req/s");
+
+	const int count = m_masterMs.size();
+	if (count == 0)
+		return;
+
+	const double dx = count > 1 ? plot.width() / (count - 1) : 0;
+	auto x = [&](int i) { return plot.left() + i * dx; };
+	auto yLatency = [&](double v) { return plot.bottom() - v / m_maxLatency * plot.height(); };
+	auto yThroughput = [&](double v) { return plot.bottom() - v / m_maxThroughput * plot.height(); };
+
+	// Latences : points
+	const qreal radius = count > 200 ? 1.5 : 2.5;
+	for (int i = 0; i < count; ++i)
+	{
+		painter.setPen(Qt::NoPen);
+		painter.setBrush(QColor(0x1f, 0x77, 0xb4));
+		painter.drawEllipse(QPointF(x(i), yLatency(m_masterMs[i])), radius, radius);
+		painter.setBrush(QColor(0xff, 0x7f, 0x0e));
+		painter.drawEllipse(QPointF(x(i), yLatency(m_slaveMs[i])), radius, radius);
+	}
+
+	// Débit : courbe
+	QPainterPath path(QPointF(x(0), yThroughput(m_throughput[0])));
+	for (int i = 1; i < count; ++i)
+		path.lineTo(x(i), yThroughput(m_throughput[i]));
+
+	painter.setBrush(Qt::NoBrush);
+	painter.setPen(QPen(QColor(0x2c, 0xa0, 0x2c), 1.5));
+	painter.drawPath(path);
+
+	// Légende
+	painter.setPen(palette().color(QPalette::Text));
+	painter.drawText(QRectF(plot.left(), plot.bottom() + 2, plot.width(), 16), Qt::AlignCenter,
+		"blue: master ms   orange: slave ms   green: throughput");
+}
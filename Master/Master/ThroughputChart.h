@@ -0,0 +1,27 @@
+#pragma once
+
+#include <QWidget>
+#include <QVector>
+
+// Graphe minimal du balayage, dessiné à la main pour ne pas dépendre de QtCharts
+// Axe gauche : latences par point (ms), axe droit : débit cumulé (req/s)
+class ThroughputChart : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit ThroughputChart(QWidget* parent = nullptr);
+
+    void clear();
+    void addPoint(double masterMs, double slaveMs, double throughput);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+
+private:
+    QVector<double> m_masterMs;
+    QVector<double> m_slaveMs;
+    QVector<double> m_throughput;
+    double m_maxLatency = 1;
+    double m_maxThroughput = 1;
+};
@@ -0,0 +1,202 @@
+#pragma once
+#include "IpcChannel.h"
+#include "IpcStats.h"
+#include "SharedMemoryMapping.h"
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <thread>
+
+// Côté slave du handshake décrit dans SharedData.h / IpcChannel.h
+// Le calcul est fourni par un callback, le SDK ne gère que le protocole
+template<typename Request, typename Response>
+class IpcSlave
+{
+public:
+    using Channel = IpcChannel<Request, Response>;
+    using ComputeFn = std::function<void(const Request& request, Response& response)>;
+    using RejectFn = std::function<void(Response& response)>;
+
+    enum class State
+    {
+        Disconnected,
+        Idle,
+        WaitingForMaster
+    };
+
+public:
+    explicit IpcSlave(const std::string& name) :
+        m_name(name)
+    {
+    }
+
+    State state() const { return m_state; }
+    uint64_t servedRequests() const { return m_servedRequests; }
+    uint64_t rejectedRequests() const { return m_rejectedRequests; }
+
+    // Bloc slave des statistiques du canal (inactif si le master n'a pas créé la région)
+    // Le SDK compte requêtes, octets et temps occupé ; les codes d'erreur sont à la charge de l'appelant
+    IpcStatsWriter& stats() { return m_stats; }
+
+    // À appeler depuis le callback de calcul : publie un résultat partiel vers le master
+    void publishPartial(int64_t position, int64_t value)
+    {
+        m_channel.publishPartial(position, value);
+        m_stats.heartbeat();
+    }
+
+    // À consulter depuis le callback de calcul : le master se contente de ce qu'il a reçu
+    bool stopRequested() const { return m_channel.stopRequested(); }
+
+    // Remplit la réponse d'une requête qui échoue au contrôle d'intégrité
+    // Sans handler, la réponse part à zéro
+    void setRejectHandler(const RejectFn& reject) { m_reject = reject; }
+
+    bool connect()
+    {
+        if (!m_mapping.open(m_name, Channel::kSize))
+            return false;
+
+        m_channel = Channel(m_mapping.data());
+        m_channel.setSlavePid(currentPid());
+        m_channel.setSlaveIntegrity(IPCIntegrity::CRC32C);
+        m_state = State::Idle;
+
+        // Statistiques optionnelles : un master sans région reste compatible
+        if (m_statsMapping.open(IpcStats::regionName(m_name), sizeof(IpcStatsRegion)) &&
+            IpcStats::isValid(static_cast<IpcStatsRegion*>(m_statsMapping.data())))
+        {
+            m_stats.attach(&static_cast<IpcStatsRegion*>(m_statsMapping.data())->slave);
+            m_stats.setPid(currentPid());
+        }
+        return true;
+    }
+
+    void disconnect()
+    {
+        m_stats.attach(nullptr);
+        m_statsMapping.close();
+        m_mapping.close();
+        m_channel = Channel();
+        m_state = State::Disconnected;
+    }
+
+    // Avance la machine à états d'un pas
+    // Renvoie true si une requête vient d'être servie
+    bool poll(const ComputeFn& compute)
+    {
+        if (m_state == State::Disconnected || !m_channel.isValid())
+            return false;
+
+        // Avant de lire flags : la requête suivante peut déjà attendre, servie dans ce même pas
+        if (m_state == State::WaitingForMaster && m_channel.responseCollected(m_servedCounter))
+            m_state = State::Idle;
+
+        const uint32_t flags = m_channel.flags();
+
+        // Un master qui réinitialise le segment efface notre pid et nos modes d'intégrité
+        if (m_state == State::Idle && m_channel.slavePid() != currentPid())
+            m_channel.setSlavePid(currentPid());
+        if (m_state == State::Idle && m_channel.slaveIntegrity() != IPCIntegrity::CRC32C)
+            m_channel.setSlaveIntegrity(IPCIntegrity::CRC32C);
+
+        if (m_state == State::Idle && flags == IPCFlags::MASTER_READY)
+        {
+            Request request;
+            uint32_t requestCounter = 0;
+            const bool intact = m_channel.readRequest(request, requestCounter);
+
+            // Indexer la réponse sur le compteur de requête puis signaler le démarrage
+            m_channel.acceptRequest(requestCounter);
+            m_servedCounter = requestCounter;
+            m_stats.setBusy(true);
+            m_stats.add(&IpcStatsBlock::requests);
+            m_stats.add(&IpcStatsBlock::bytesIn, sizeof(Request));
+
+            Response response{};
+            if (intact)
+            {
+                compute(request, response);
+            }
+            else
+            {
+                m_rejectedRequests++;
+                if (m_reject)
+                    m_reject(response);
+            }
+
+            m_channel.postResponse(response);
+            m_stats.add(&IpcStatsBlock::responses);
+            m_stats.add(&IpcStatsBlock::bytesOut, sizeof(Response));
+            m_stats.setBusy(false);
+            m_state = State::WaitingForMaster;
+            m_servedRequests++;
+            return true;
+        }
+
+        return false;
+    }
+
+    // Boucle bloquante jusqu'à stop == true
+    // pollInterval nul : attente active (yield), latence minimale au prix d'un cœur
+    void run(const ComputeFn& compute, const std::atomic<bool>& stop,
+        std::chrono::microseconds pollInterval = std::chrono::microseconds(0))
+    {
+        auto lastHeartbeat = std::chrono::steady_clock::now();
+
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            if (m_state == State::Disconnected && !connect())
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(500));
+                continue;
+            }
+
+            // Signe de vie pour ipc_top, même sans trafic
+            const auto now = std::chrono::steady_clock::now();
+            if (now - lastHeartbeat >= std::chrono::seconds(1))
+            {
+                m_stats.heartbeat();
+                lastHeartbeat = now;
+            }
+
+            if (poll(compute))
+                continue;
+
+            if (pollInterval.count() == 0)
+                std::this_thread::yield();
+            else
+                std::this_thread::sleep_for(pollInterval);
+        }
+    }
+
+private:
+    static uint32_t currentPid()
+    {
+#ifdef _WIN32
+        return static_cast<uint32_t>(_getpid());
+#else
+        return static_cast<uint32_t>(getpid());
+#endif
+    }
+
+private:
+    std::string m_name;
+    SharedMemoryMapping m_mapping;
+    SharedMemoryMapping m_statsMapping;
+    IpcStatsWriter m_stats;
+    Channel m_channel;
+    State m_state = State::Disconnected;
+    uint32_t m_servedCounter = 0;   // requestCounter de la dernière réponse postée
+    uint64_t m_servedRequests = 0;
+    uint64_t m_rejectedRequests = 0;
+    RejectFn m_reject;
+};
@@ -0,0 +1,54 @@
+#include "SharedMemoryMapping.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+SharedMemoryMapping::~SharedMemoryMapping()
+{
+	close();
+}
+
+bool SharedMemoryMapping::open(const std::string& name, size_t size, bool readOnly)
+{
+	close();
+
+#ifdef _WIN32
+	std::wstring fullName = L"Local\\" + std::wstring(name.begin(), name.end());
+	DWORD access = readOnly ? FILE_MAP_READ : FILE_MAP_ALL_ACCESS;
+
+	HANDLE handle = OpenFileMappingW(access, FALSE, fullName.c_str());
+	if (handle == nullptr)
+		return false;
+
+	void* data = MapViewOfFile(handle, access, 0, 0, size);
+	if (data == nullptr)
+	{
+		CloseHandle(handle);
+		return false;
+	}
+
+	m_handle = handle;
+	m_data = data;
+	m_size = size;
+	return true;
+#else
+	(void)name;
+	(void)size;
+	(void)readOnly;
+	return false;
+#endif
+}
+
+void SharedMemoryMapping::close()
+{
+#ifdef _WIN32
+	if (m_data)
+		UnmapViewOfFile(m_data);
+	if (m_handle)
+		CloseHandle(static_cast<HANDLE>(m_handle));
+#endif
+	m_data = nullptr;
+	m_handle = nullptr;
+	m_size = 0;
+}
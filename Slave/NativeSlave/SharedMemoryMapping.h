@@ -0,0 +1,27 @@
+#pragma once
+#include <stddef.h>
+#include <string>
+
+// Ouverture d'un mapping nommé créé par le master
+class SharedMemoryMapping
+{
+public:
+    SharedMemoryMapping() = default;
+    ~SharedMemoryMapping();
+
+    SharedMemoryMapping(const SharedMemoryMapping&) = delete;
+    SharedMemoryMapping& operator=(const SharedMemoryMapping&) = delete;
+
+    // name sans préfixe, ex: "ipc_masterslave_shm" (=> "Local\\ipc_masterslave_shm")
+    bool open(const std::string& name, size_t size, bool readOnly = false);
+    void close();
+
+    bool isOpen() const { return m_data != nullptr; }
+    void* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+private:
+    void* m_handle = nullptr;
+    void* m_data = nullptr;
+    size_t m_size = 0;
+};
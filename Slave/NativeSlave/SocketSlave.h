@@ -0,0 +1,163 @@
+#pragma once
+#include "IpcChannel.h"
+#include "IpcSocket.h"
+#include "IpcStats.h"
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <chrono>
+#include <functional>
+#include <string>
+
+// Côté slave du transport socket (cf. SocketTransport côté master)
+// Même callback de calcul et même contrôle d'intégrité qu'IpcSlave, mais le slave
+// attend ses requêtes dans select() au lieu d'interroger le segment
+template<typename Request, typename Response>
+class SocketSlave
+{
+public:
+    using Channel = IpcChannel<Request, Response>;
+    using ComputeFn = std::function<void(const Request& request, Response& response)>;
+    using RejectFn = std::function<void(Response& response)>;
+
+public:
+    // stats : écrivain du bloc slave, partagé avec IpcSlave si les deux transports tournent
+    SocketSlave(const std::string& channelName, IpcStatsWriter& stats) :
+        m_path(IpcSocket::pathFor(channelName)),
+        m_stats(stats)
+    {
+    }
+
+    bool isConnected() const { return m_socket.isOpen(); }
+    uint64_t servedRequests() const { return m_servedRequests; }
+    uint64_t rejectedRequests() const { return m_rejectedRequests; }
+
+    void setRejectHandler(const RejectFn& reject) { m_reject = reject; }
+
+    // Le master crée le socket au démarrage : on retente au plus une fois par seconde
+    bool connect()
+    {
+        const auto now = std::chrono::steady_clock::now();
+        if (now - m_lastAttempt < std::chrono::seconds(1))
+            return false;
+        m_lastAttempt = now;
+
+        if (!m_socket.connect(m_path))
+            return false;
+
+        const uint32_t pid = currentPid();
+        if (!m_socket.sendFrame(IPCFrame::HELLO, 0, IPCIntegrity::CRC32C, 0, &pid, sizeof(pid)))
+        {
+            m_socket.close();
+            return false;
+        }
+        return true;
+    }
+
+    void disconnect()
+    {
+        m_socket.close();
+    }
+
+    // À appeler depuis le callback de calcul
+    void publishPartial(int64_t position, int64_t value)
+    {
+        const IpcPartial partial = { 0, m_requestCounter, position, value };
+        m_socket.sendFrame(IPCFrame::PARTIAL, m_requestCounter, 0, 0, &partial, sizeof(partial));
+        m_stats.heartbeat();
+    }
+
+    // À consulter depuis le callback de calcul : lit sans attendre un éventuel STOP
+    bool stopRequested()
+    {
+        IpcFrameHeader header;
+        uint8_t payload[IPCFrame::MAX_PAYLOAD];
+
+        while (!m_stopRequested && m_socket.receiveFrame(header, payload, sizeof(payload), 0) == IpcSocket::Result::Frame)
+        {
+            if (header.type == IPCFrame::STOP && header.counter == m_requestCounter)
+                m_stopRequested = true;
+        }
+        return m_stopRequested;
+    }
+
+    // Attend au plus timeoutMs une requête et la sert
+    // Renvoie true si une requête vient d'être servie
+    bool poll(const ComputeFn& compute, int timeoutMs)
+    {
+        if (!isConnected() && !connect())
+            return false;
+
+        IpcFrameHeader header;
+        uint8_t payload[IPCFrame::MAX_PAYLOAD];
+
+        const IpcSocket::Result result = m_socket.receiveFrame(header, payload, sizeof(payload), timeoutMs);
+        if (result != IpcSocket::Result::Frame)
+            return false;
+
+        // STOP arrivé après la réponse : sans objet
+        if (header.type != IPCFrame::REQUEST || header.length != sizeof(Request))
+            return false;
+
+        Request request;
+        memcpy(&request, payload, sizeof(Request));
+
+        const bool intact = header.aux != IPCIntegrity::CRC32C ||
+            header.crc == Channel::requestChecksum(request, header.counter);
+
+        m_requestCounter = header.counter;
+        m_stopRequested = false;
+
+        m_socket.sendFrame(IPCFrame::STARTED, m_requestCounter);
+        m_stats.setBusy(true);
+        m_stats.add(&IpcStatsBlock::requests);
+        m_stats.add(&IpcStatsBlock::bytesIn, sizeof(Request));
+
+        Response response{};
+        if (intact)
+        {
+            compute(request, response);
+        }
+        else
+        {
+            m_rejectedRequests++;
+            if (m_reject)
+                m_reject(response);
+        }
+
+        const uint32_t crc = header.aux == IPCIntegrity::CRC32C ? Channel::responseChecksum(response, m_requestCounter) : 0;
+        if (!m_socket.sendFrame(IPCFrame::RESPONSE, m_requestCounter, 0, crc, &response, sizeof(Response)))
+            m_socket.close();
+
+        m_stats.add(&IpcStatsBlock::responses);
+        m_stats.add(&IpcStatsBlock::bytesOut, sizeof(Response));
+        m_stats.setBusy(false);
+        m_servedRequests++;
+        return true;
+    }
+
+private:
+    static uint32_t currentPid()
+    {
+#ifdef _WIN32
+        return static_cast<uint32_t>(_getpid());
+#else
+        return static_cast<uint32_t>(getpid());
+#endif
+    }
+
+private:
+    std::string m_path;
+    IpcSocket m_socket;
+    IpcStatsWriter& m_stats;
+    std::chrono::steady_clock::time_point m_lastAttempt;
+    uint32_t m_requestCounter = 0;
+    bool m_stopRequested = false;
+    uint64_t m_servedRequests = 0;
+    uint64_t m_rejectedRequests = 0;
+    RejectFn m_reject;
+};
@@ -0,0 +1,398 @@
+// Slave natif de référence
+// Même protocole que slave.py, sans l'interpréteur : sert à mesurer le coût
+// propre de l'IPC côté master et à faire des tests d'endurance
+
+#include "SharedData.h"
+#include "SocketSlave.h"
+#include "IpcSlave.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <filesystem>
+#include <fstream>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef IPC_NAME
+#define IPC_NAME "ipc_masterslave_shm"
+#endif
+
+namespace
+{
+    enum class TransportMode
+    {
+        SharedMemory,   // attente active sur le segment (comportement historique)
+        Socket,         // requêtes reçues uniquement par le socket du canal
+        Auto            // les deux, en suivant le transport choisi par le master
+    };
+
+    struct Options
+    {
+        std::string shmName = IPC_NAME;
+        TransportMode transport = TransportMode::Auto;
+        int latencyMs = 0;      // latence de calcul synthétique
+        int jitterMs = 0;       // +/- aléatoire sur la latence
+        int pollUs = 0;         // 0 = attente active
+        int reportEvery = 100;  // afficher un bilan toutes les N requêtes
+        int partials = 10;      // résultats partiels publiés par requête (0 = aucun)
+        bool writeFile = true;
+        bool benchCrc = false;  // mesurer le coût du contrôle d'intégrité puis quitter
+    };
+
+    std::atomic<bool> g_stop{ false };
+    volatile uint32_t g_crcSink = 0;
+
+    void onSignal(int)
+    {
+        g_stop = true;
+    }
+
+    void printUsage(const char* exe)
+    {
+        printf("Usage: %s [--shm NAME] [--transport shm|socket|auto] [--latency-ms N] [--jitter-ms N] [--poll-us N] [--report-every N] [--partials N] [--no-file] [--bench-crc]\n", exe);
+    }
+
+    bool parseOptions(int argc, char* argv[], Options& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const char* arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+
+            if (strcmp(arg, "--shm") == 0 && hasValue)
+                options.shmName = argv[++i];
+            else if (strcmp(arg, "--transport") == 0 && hasValue)
+            {
+                const char* mode = argv[++i];
+                if (strcmp(mode, "shm") == 0)
+                    options.transport = TransportMode::SharedMemory;
+                else if (strcmp(mode, "socket") == 0)
+                    options.transport = TransportMode::Socket;
+                else if (strcmp(mode, "auto") == 0)
+                    options.transport = TransportMode::Auto;
+                else
+                    return false;
+            }
+            else if (strcmp(arg, "--latency-ms") == 0 && hasValue)
+                options.latencyMs = atoi(argv[++i]);
+            else if (strcmp(arg, "--jitter-ms") == 0 && hasValue)
+                options.jitterMs = atoi(argv[++i]);
+            else if (strcmp(arg, "--poll-us") == 0 && hasValue)
+                options.pollUs = atoi(argv[++i]);
+            else if (strcmp(arg, "--report-every") == 0 && hasValue)
+                options.reportEvery = atoi(argv[++i]);
+            else if (strcmp(arg, "--partials") == 0 && hasValue)
+                options.partials = atoi(argv[++i]);
+            else if (strcmp(arg, "--no-file") == 0)
+                options.writeFile = false;
+            else if (strcmp(arg, "--bench-crc") == 0)
+                options.benchCrc = true;
+            else
+                return false;
+        }
+        return true;
+    }
+
+    // Coût par message d'un CRC32C, en ns, moyenné sur iterations appels
+    template<typename Fn>
+    double timeCrc(Fn crc, const void* data, size_t size, int iterations)
+    {
+        uint32_t sink = 0;
+        const auto begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i)
+            sink ^= crc(sink, data, size);
+        const auto end = std::chrono::steady_clock::now();
+
+        // Empêche le compilateur d'éliminer la boucle
+        g_crcSink = g_crcSink ^ sink;
+
+        return std::chrono::duration<double, std::nano>(end - begin).count() / iterations;
+    }
+
+    // Coût du contrôle d'intégrité sur un message réel et sur de gros blocs
+    void benchCrc()
+    {
+        printf("CRC32C hardware (SSE4.2): %s\n", Crc32c::hasHardware() ? "yes" : "no");
+        printf("%12s %14s %14s %12s\n", "bytes", "software ns", "hardware ns", "hw GB/s");
+
+        const size_t sizes[] = { sizeof(SumRequest) + 4, sizeof(SumResponse) + 4, 4096, 1 << 20 };
+        std::vector<uint8_t> buffer(sizes[3]);
+        for (size_t i = 0; i < buffer.size(); ++i)
+            buffer[i] = static_cast<uint8_t>(i * 31 + 7);
+
+        for (size_t size : sizes)
+        {
+            const int iterations = static_cast<int>(std::max<size_t>(16, (64u << 20) / size));
+            const double software = timeCrc(Crc32c::updateSoftware, buffer.data(), size, iterations);
+            const double hardware = Crc32c::hasHardware()
+                ? timeCrc(Crc32c::update, buffer.data(), size, iterations) : software;
+
+            printf("%12zu %14.1f %14.1f %12.2f\n", size, software, hardware, size / hardware);
+        }
+    }
+
+    // Somme de start à end (inclus), formule de Gauss sur 64 bits
+    int64_t gaussSum(int64_t start, int64_t end)
+    {
+        return (end - start + 1) * (start + end) / 2;
+    }
+
+    int32_t computeSum(int32_t start, int32_t end, int32_t& result)
+    {
+        result = 0;
+
+        if (start > end)
+            return IPCErrorCode::START_GREATER_THAN_END;
+
+        const int64_t sum = gaussSum(start, end);
+
+        if (sum > INT32_MAX || sum < INT32_MIN)
+            return IPCErrorCode::OVERFLOW_ERROR;
+
+        result = static_cast<int32_t>(sum);
+        return IPCErrorCode::SUCCESS;
+    }
+
+    // Même format que slave.py : le master y relit "Duration:"
+    int32_t createResultFile(const char* folder, int32_t result, long long elapsedMs, char* fileNameOut, size_t fileNameSize)
+    {
+        using namespace std::chrono;
+
+        const auto now = system_clock::now();
+        const time_t seconds = system_clock::to_time_t(now);
+        const int millis = static_cast<int>(duration_cast<milliseconds>(now.time_since_epoch()).count() % 1000);
+
+        tm local{};
+#ifdef _WIN32
+        localtime_s(&local, &seconds);
+#else
+        localtime_r(&seconds, &local);
+#endif
+
+        char stamp[32];
+        strftime(stamp, sizeof(stamp), "%Y%m%d_%H%M%S", &local);
+
+#ifdef _WIN32
+        const unsigned pid = static_cast<unsigned>(_getpid());
+#else
+        const unsigned pid = static_cast<unsigned>(getpid());
+#endif
+
+        // pid et numéro : deux requêtes dans la même ms (file enchaînée, canal de secours) ne s'écrasent pas
+        static unsigned index = 0;
+        char fileName[96];
+        snprintf(fileName, sizeof(fileName), "result_%s_%03d_%u_%u.txt", stamp, millis, pid, ++index);
+
+        std::error_code ec;
+        std::filesystem::path dir = std::filesystem::u8path(folder);
+        std::filesystem::create_directories(dir, ec);
+
+        std::ofstream out(dir / fileName, std::ios::trunc);
+        if (!out)
+            return IPCErrorCode::FILE_WRITE_ERROR;
+
+        out << "Result: " << result << "\n";
+        out << "Duration: " << elapsedMs << "\n";
+        if (!out)
+            return IPCErrorCode::FILE_WRITE_ERROR;
+
+        snprintf(fileNameOut, fileNameSize, "%s", fileName);
+        return IPCErrorCode::SUCCESS;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    if (options.benchCrc)
+    {
+        benchCrc();
+        return 0;
+    }
+
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    printf("==================================================\n");
+    printf("NATIVE SLAVE STARTED\n");
+    printf("Shared memory: %s (%u bytes)\n", options.shmName.c_str(), SumChannel::kSize);
+    printf("Socket: %s (%s)\n", IpcSocket::pathFor(options.shmName).c_str(),
+        options.transport == TransportMode::SharedMemory ? "disabled" : options.transport == TransportMode::Socket ? "only" : "auto");
+    printf("Latency: %d ms (+/- %d ms), poll: %d us\n", options.latencyMs, options.jitterMs, options.pollUs);
+    printf("==================================================\n");
+
+    std::mt19937 rng(std::random_device{}());
+    std::uniform_int_distribution<int> jitter(-options.jitterMs, options.jitterMs);
+
+    IpcSlave<SumRequest, SumResponse> slave(options.shmName);
+    SocketSlave<SumRequest, SumResponse> socketSlave(options.shmName, slave.stats());
+
+    auto reject = [&slave](SumResponse& response)
+    {
+        printf("! Request failed integrity check\n");
+        response.codeResult = IPCErrorCode::INTEGRITY_ERROR;
+        slave.stats().addError(IPCErrorCode::INTEGRITY_ERROR);
+    };
+    slave.setRejectHandler(reject);
+    socketSlave.setRejectHandler(reject);
+
+    auto windowStart = std::chrono::steady_clock::now();
+
+    // viaSocket : transport par lequel la requête est arrivée, pour les partiels et l'arrêt
+    auto compute = [&](const SumRequest& request, SumResponse& response, bool viaSocket)
+    {
+        const auto begin = std::chrono::steady_clock::now();
+
+        int32_t result = 0;
+        int32_t code = computeSum(request.startNumber, request.endNumber, result);
+
+        const int latency = std::max(0, options.latencyMs + (options.jitterMs > 0 ? jitter(rng) : 0));
+
+        if (code == IPCErrorCode::SUCCESS && options.partials > 0)
+        {
+            // Plage découpée en tranches régulières : un partiel par tranche,
+            // le master peut demander l'arrêt entre deux tranches
+            const int64_t span = static_cast<int64_t>(request.endNumber) - request.startNumber + 1;
+
+            for (int slice = 1; slice <= options.partials; ++slice)
+            {
+                if (latency > 0)
+                    std::this_thread::sleep_for(std::chrono::microseconds(latency * 1000LL / options.partials));
+
+                const int64_t position = request.startNumber + span * slice / options.partials - 1;
+                const int64_t partial = gaussSum(request.startNumber, position);
+                if (viaSocket)
+                    socketSlave.publishPartial(position, partial);
+                else
+                    slave.publishPartial(position, partial);
+
+                if (slice < options.partials && (viaSocket ? socketSlave.stopRequested() : slave.stopRequested()))
+                {
+                    code = IPCErrorCode::STOPPED;
+                    result = partial >= INT32_MIN && partial <= INT32_MAX ? static_cast<int32_t>(partial) : 0;
+                    printf("> Stopped by master at %lld\n", static_cast<long long>(position));
+                    break;
+                }
+            }
+        }
+        else if (latency > 0)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(latency));
+        }
+
+        const long long elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - begin).count();
+
+        if (code == IPCErrorCode::SUCCESS && options.writeFile)
+        {
+            code = createResultFile(request.resultsFolderPath, result, elapsedMs,
+                response.resultFileName, sizeof(response.resultFileName));
+        }
+
+        response.codeResult = code;
+        slave.stats().addError(code);
+        response.sumResult = code == IPCErrorCode::SUCCESS || code == IPCErrorCode::STOPPED ? result : 0;
+
+        const uint64_t served = slave.servedRequests() + socketSlave.servedRequests() + 1;
+        if (options.reportEvery > 0 && served % options.reportEvery == 0)
+        {
+            const auto now = std::chrono::steady_clock::now();
+            const double seconds = std::chrono::duration<double>(now - windowStart).count();
+            printf("> %llu requests served, %.1f req/s\n",
+                static_cast<unsigned long long>(served), options.reportEvery / seconds);
+            windowStart = now;
+        }
+    };
+
+    auto computeShm = [&](const SumRequest& request, SumResponse& response) { compute(request, response, false); };
+    auto computeSocket = [&](const SumRequest& request, SumResponse& response) { compute(request, response, true); };
+
+    if (options.transport == TransportMode::SharedMemory)
+    {
+        slave.run(computeShm, g_stop, std::chrono::microseconds(options.pollUs));
+    }
+    else
+    {
+        // Auto : le slave suit le transport de la dernière requête
+        // Côté socket il dort dans select() et ne regarde le segment que toutes les 20 ms ;
+        // une requête en mémoire partagée le ramène à l'attente active
+        bool socketActive = options.transport == TransportMode::Socket;
+        auto lastHeartbeat = std::chrono::steady_clock::now();
+        auto lastConnect = lastHeartbeat - std::chrono::seconds(1);
+
+        while (!g_stop)
+        {
+            const auto now = std::chrono::steady_clock::now();
+
+            // Mapping ouvert aussi en mode socket seul : statistiques et pid pour le master
+            if (slave.state() == IpcSlave<SumRequest, SumResponse>::State::Disconnected && now - lastConnect >= std::chrono::milliseconds(500))
+            {
+                slave.connect();
+                lastConnect = now;
+            }
+
+            if (now - lastHeartbeat >= std::chrono::seconds(1))
+            {
+                slave.stats().heartbeat();
+                lastHeartbeat = now;
+            }
+
+            if (options.transport == TransportMode::Socket)
+            {
+                if (!socketSlave.poll(computeSocket, 100) && !socketSlave.isConnected())
+                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                continue;
+            }
+
+            // Aucun transport disponible : le master n'est pas encore lancé
+            if (slave.state() == IpcSlave<SumRequest, SumResponse>::State::Disconnected && !socketSlave.isConnected() && !socketSlave.connect())
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                continue;
+            }
+
+            if (socketActive && socketSlave.isConnected())
+            {
+                if (!socketSlave.poll(computeSocket, 20) && slave.poll(computeShm))
+                    socketActive = false;
+                continue;
+            }
+
+            if (slave.poll(computeShm))
+                continue;
+
+            if (socketSlave.poll(computeSocket, 0))
+            {
+                socketActive = true;
+                continue;
+            }
+
+            if (options.pollUs == 0)
+                std::this_thread::yield();
+            else
+                std::this_thread::sleep_for(std::chrono::microseconds(options.pollUs));
+        }
+    }
+
+    printf("Native slave stopped after %llu requests (%llu rejected), %llu over socket (%llu rejected)\n",
+        static_cast<unsigned long long>(slave.servedRequests()),
+        static_cast<unsigned long long>(slave.rejectedRequests()),
+        static_cast<unsigned long long>(socketSlave.servedRequests()),
+        static_cast<unsigned long long>(socketSlave.rejectedRequests()));
+    return 0;
+}
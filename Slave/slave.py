@@ -1,6 +1,10 @@
+import argparse
 import struct
 import time
 import os
+import json
+import re
+import tempfile
 import ctypes
 from ctypes import wintypes
 from dataclasses import dataclass
@@ -46,9 +50,83 @@ OFFSET_RESULT_FILE = 280
 OFFSET_CODE = 536
 OFFSET_SUM = 540
 OFFSET_FLAGS = 544
+OFFSET_SLAVE_PID = None     # présent seulement via le descripteur
+OFFSET_INTEGRITY = None
+OFFSET_REQ_CRC = None
+OFFSET_RES_CRC = None
+OFFSET_SLAVE_INTEGRITY = None
+
+# Plages couvertes par les CRC : (offset, taille), via le descripteur
+CRC_REQUEST_RANGE = None
+CRC_RESPONSE_RANGE = None
+
+# Anneau de résultats partiels (offset, nombre d'entrées, taille d'une entrée), via le descripteur
+OFFSET_PARTIAL_HEAD = None
+OFFSET_CONTROL = None
+PARTIALS_RING = None
+
+# Publier un partiel au plus toutes les PARTIAL_INTERVAL secondes
+PARTIAL_INTERVAL = 0.05
 
 EXPECTED_MAGIC = 0xDEADBEEF
 
+# Versions de layout connues (cf. IPC_VERSION) ; chacune ne fait qu'ajouter des champs
+# après ceux de la précédente, les offsets intégrés (version 1) restent donc valides
+SUPPORTED_VERSIONS = (1, 2, 3, 4, 5)
+
+# Version du descripteur chargé, None avec les offsets intégrés
+LAYOUT_VERSION = None
+
+# Descripteur de layout généré par le master (cf. IpcChannel::layoutJson)
+LAYOUT_FILE = os.path.join(tempfile.gettempdir(), f"{SHM_NAME}.layout.json")
+
+def layout_file_for(shm_name: str) -> str:
+    """Descripteur du canal : écrit par le master sous le nom de base, sans le suffixe _<n> des canaux de secours"""
+    for name in (shm_name, re.sub(r"_\d+$", "", shm_name)):
+        path = os.path.join(tempfile.gettempdir(), f"{name}.layout.json")
+        if os.path.exists(path):
+            return path
+    return os.path.join(tempfile.gettempdir(), f"{shm_name}.layout.json")
+
+# Champ du descripteur -> offset utilisé par ce script
+LAYOUT_FIELDS = {
+    "magic": "OFFSET_MAGIC",
+    "version": "OFFSET_VERSION",
+    "resultsFolderPath": "OFFSET_FOLDER",
+    "startNumber": "OFFSET_START",
+    "endNumber": "OFFSET_END",
+    "requestCounter": "OFFSET_REQ_COUNTER",
+    "responseCounter": "OFFSET_RES_COUNTER",
+    "resultFileName": "OFFSET_RESULT_FILE",
+    "codeResult": "OFFSET_CODE",
+    "sumResult": "OFFSET_SUM",
+    "flags": "OFFSET_FLAGS",
+}
+
+# Région de statistiques "<canal>_stats" (cf. IpcStats.h)
+STATS_SUFFIX = "_stats"
+STATS_MAGIC = 0x57A7C0DE
+STATS_VERSION = 2
+STATS_SIZE = 448
+STATS_BLOCK_SIZE = 192
+STATS_SLAVE_BLOCK = 256
+
+# Offsets dans un bloc, tous les champs sont des uint64
+STATS_PID = 0
+STATS_HEARTBEAT_MS = 8
+STATS_REQUESTS = 16
+STATS_RESPONSES = 24
+STATS_ERRORS = 32
+STATS_COUNTER_MISMATCHES = 112
+STATS_TIMEOUTS = 120
+STATS_BUSY_NS = 128
+STATS_IDLE_NS = 136
+STATS_BYTES_IN = 144
+STATS_BYTES_OUT = 152
+
+# Codes comptés séparément, dans l'ordre des slots ; le dernier slot regroupe les autres
+STATS_ERROR_CODES = [0, 1, 2, 3, 4, 96, 97, 98, 99]
+
 # Flags
 class IPCFlags:
     IDLE = 0x0
@@ -56,12 +134,25 @@ class IPCFlags:
     SLAVE_STARTED = 0x2
     SLAVE_FINISHED = 0x4
 
+# Commandes du master
+class IPCControl:
+    NONE = 0x0
+    STOP = 0x1
+
+# Modes d'intégrité
+class IPCIntegrity:
+    NONE = 0x0
+    CRC32C = 0x1
+
 # Error codes
 class ErrorCode:
     SUCCESS = 0
     START_GREATER_THAN_END = 1
     OVERFLOW_ERROR = 2
     FILE_WRITE_ERROR = 3
+    STOPPED = 4
+    TIMEOUT_ERROR = 96
+    INTEGRITY_ERROR = 97
     UNKNOWN_ERROR = 99
 
 # États
@@ -87,6 +178,129 @@ class SharedData:
     folder: str = ""
     result_file: str = ""
 
+def load_layout(path: str) -> bool:
+    """Remplace les offsets par défaut par ceux du descripteur du master"""
+    global SHM_SIZE, OFFSET_SLAVE_PID, OFFSET_INTEGRITY, OFFSET_REQ_CRC, OFFSET_RES_CRC, OFFSET_SLAVE_INTEGRITY
+    global CRC_REQUEST_RANGE, CRC_RESPONSE_RANGE
+    global OFFSET_PARTIAL_HEAD, OFFSET_CONTROL, PARTIALS_RING
+    global LAYOUT_VERSION
+
+    try:
+        with open(path, "r") as f:
+            layout = json.load(f)
+    except (OSError, ValueError):
+        return False
+
+    if layout.get("magic") != EXPECTED_MAGIC or layout.get("version") not in SUPPORTED_VERSIONS:
+        print("! Layout descriptor mismatch (magic/version), using built-in offsets")
+        return False
+
+    fields = {field["name"]: field for field in layout.get("fields", [])}
+    missing = [name for name in LAYOUT_FIELDS if name not in fields]
+    if missing:
+        print(f"! Layout descriptor missing fields {missing}, using built-in offsets")
+        return False
+
+    for name, constant in LAYOUT_FIELDS.items():
+        globals()[constant] = fields[name]["offset"]
+    SHM_SIZE = layout["size"]
+    LAYOUT_VERSION = layout["version"]
+
+    # Champs optionnels
+    OFFSET_SLAVE_PID = fields["slavePid"]["offset"] if "slavePid" in fields else None
+    OFFSET_SLAVE_INTEGRITY = fields["slaveIntegrity"]["offset"] if "slaveIntegrity" in fields else None
+
+    crc = layout.get("crc")
+    if crc and crc.get("algorithm") == "crc32c" and all(name in fields for name in ("integrity", "requestCrc", "responseCrc")):
+        OFFSET_INTEGRITY = fields["integrity"]["offset"]
+        OFFSET_REQ_CRC = fields["requestCrc"]["offset"]
+        OFFSET_RES_CRC = fields["responseCrc"]["offset"]
+        CRC_REQUEST_RANGE = (crc["request"]["offset"], crc["request"]["size"])
+        CRC_RESPONSE_RANGE = (crc["response"]["offset"], crc["response"]["size"])
+    else:
+        OFFSET_INTEGRITY = OFFSET_REQ_CRC = OFFSET_RES_CRC = None
+        CRC_REQUEST_RANGE = CRC_RESPONSE_RANGE = None
+
+    partials = layout.get("partials")
+    if partials and partials.get("recordSize") == 24 and "partialHead" in fields and "control" in fields:
+        OFFSET_PARTIAL_HEAD = fields["partialHead"]["offset"]
+        OFFSET_CONTROL = fields["control"]["offset"]
+        PARTIALS_RING = (partials["offset"], partials["count"], partials["recordSize"])
+    else:
+        OFFSET_PARTIAL_HEAD = OFFSET_CONTROL = PARTIALS_RING = None
+    return True
+
+class PartialPublisher:
+    """Publie les résultats partiels d'une requête dans l'anneau du segment (cf. IpcChannel::publishPartial)"""
+
+    def __init__(self, ptr, request_counter: int):
+        self.ptr = ptr
+        self.request_counter = request_counter
+        self.sequence = 0   # le master remet partialHead à 0 à chaque requête
+        self.last_publish = time.perf_counter()
+
+    def enabled(self) -> bool:
+        return PARTIALS_RING is not None
+
+    def due(self) -> bool:
+        return self.enabled() and time.perf_counter() - self.last_publish >= PARTIAL_INTERVAL
+
+    def publish(self, position: int, value: int):
+        if not self.enabled():
+            return
+        ring_offset, count, record_size = PARTIALS_RING
+        self.sequence = (self.sequence + 1) & 0xFFFFFFFF
+        sequence = self.sequence
+        slot = ring_offset + ((sequence - 1) % count) * record_size
+
+        # sequence à 0 pendant l'écriture : le master ignore une entrée incomplète
+        write_uint32(self.ptr, slot, 0)
+        ctypes.memmove(self.ptr + slot + 4, struct.pack("<Iqq", self.request_counter, position, value), 20)
+        write_uint32(self.ptr, slot, sequence)
+        write_uint32(self.ptr, OFFSET_PARTIAL_HEAD, sequence)
+        self.last_publish = time.perf_counter()
+
+    def stop_requested(self) -> bool:
+        if OFFSET_CONTROL is None:
+            return False
+        return ctypes.c_uint32.from_address(self.ptr + OFFSET_CONTROL).value == IPCControl.STOP
+
+def _make_crc32c_table():
+    table = []
+    for i in range(256):
+        crc = i
+        for _ in range(8):
+            crc = (crc >> 1) ^ 0x82F63B78 if crc & 1 else crc >> 1
+        table.append(crc)
+    return table
+
+CRC32C_TABLE = _make_crc32c_table()
+
+def crc32c(data: bytes) -> int:
+    """CRC32C logiciel, identique à Crc32c::compute côté C++"""
+    crc = 0xFFFFFFFF
+    for byte in data:
+        crc = CRC32C_TABLE[(crc ^ byte) & 0xFF] ^ (crc >> 8)
+    return crc ^ 0xFFFFFFFF
+
+def integrity_enabled(raw: bytes) -> bool:
+    return OFFSET_INTEGRITY is not None and read_uint32(raw, OFFSET_INTEGRITY) == IPCIntegrity.CRC32C
+
+def request_intact(raw: bytes) -> bool:
+    """Vérifie la requête (inputs + requestCounter) contre sa somme de contrôle"""
+    if not integrity_enabled(raw):
+        return True
+    offset, size = CRC_REQUEST_RANGE
+    return crc32c(raw[offset:offset + size]) == read_uint32(raw, OFFSET_REQ_CRC)
+
+def write_response_crc(ptr):
+    """Signe la réponse telle qu'écrite en mémoire (responseCounter + outputs)"""
+    raw = read_shared_memory(ptr, SHM_SIZE)
+    if not integrity_enabled(raw):
+        return
+    offset, size = CRC_RESPONSE_RANGE
+    write_uint32(ptr, OFFSET_RES_CRC, crc32c(raw[offset:offset + size]))
+
 def read_c_string(buffer: bytes) -> str:
     return buffer.split(b'\x00', 1)[0].decode(errors="ignore")
 
@@ -130,6 +344,12 @@ def extract_data_shared_memory(raw_data: bytes, out_data: SharedData):
         return False
 
     out_data.version = read_uint32(raw_data, OFFSET_VERSION)
+    if out_data.version not in SUPPORTED_VERSIONS:
+        return False
+    # Segment recréé par un master d'une autre version que celle du descripteur
+    if LAYOUT_VERSION is not None and out_data.version != LAYOUT_VERSION:
+        return False
+
     out_data.start = read_int32(raw_data, OFFSET_START)
     out_data.end = read_int32(raw_data, OFFSET_END)
 
@@ -146,6 +366,64 @@ def extract_data_shared_memory(raw_data: bytes, out_data: SharedData):
 
     return True
 
+class StatsWriter:
+    """Bloc slave de la région de statistiques, seul écrivain de ce bloc"""
+
+    def __init__(self):
+        self.handle = None
+        self.block = None
+        self.busy = False
+        self.last_transition = time.perf_counter_ns()
+
+    def attach(self, channel_name: str) -> bool:
+        handle, ptr = shared_memory_exists(channel_name + STATS_SUFFIX, STATS_SIZE)
+        if not handle:
+            return False
+
+        header = read_shared_memory(ptr, 16)
+        magic, version, block_size, error_slots = struct.unpack_from("IIII", header, 0)
+        if magic != STATS_MAGIC or version != STATS_VERSION or block_size != STATS_BLOCK_SIZE \
+                or error_slots != len(STATS_ERROR_CODES) + 1:
+            print("! Stats region mismatch, statistics disabled")
+            kernel32.UnmapViewOfFile(ptr)
+            kernel32.CloseHandle(handle)
+            return False
+
+        self.handle = handle
+        self.block = ptr + STATS_SLAVE_BLOCK
+        self.last_transition = time.perf_counter_ns()
+        self.store(STATS_PID, os.getpid())
+        self.heartbeat()
+        return True
+
+    def load(self, offset: int) -> int:
+        return ctypes.c_uint64.from_address(self.block + offset).value
+
+    def store(self, offset: int, value: int):
+        # Écriture 64 bits alignée : jamais déchirée pour un lecteur x64
+        ctypes.c_uint64.from_address(self.block + offset).value = value & 0xFFFFFFFFFFFFFFFF
+
+    def add(self, offset: int, delta: int = 1):
+        if self.block:
+            self.store(offset, self.load(offset) + delta)
+
+    def add_error(self, code: int):
+        slot = STATS_ERROR_CODES.index(code) if code in STATS_ERROR_CODES else len(STATS_ERROR_CODES)
+        self.add(STATS_ERRORS + 8 * slot)
+
+    def set_busy(self, busy: bool):
+        if busy == self.busy:
+            return
+        now = time.perf_counter_ns()
+        self.add(STATS_BUSY_NS if self.busy else STATS_IDLE_NS, now - self.last_transition)
+        self.busy = busy
+        self.last_transition = now
+        self.heartbeat()
+
+    def heartbeat(self):
+        if self.block:
+            self.store(STATS_HEARTBEAT_MS, int(time.time() * 1000))
+
 def compute_sum(start: int, end: int):
     """Calcule la somme de start à end (inclus)"""
     if start > end:
@@ -172,7 +450,7 @@ def compute_sum(start: int, end: int):
         print(f"Error computing sum: {e}")
         return (ErrorCode.UNKNOWN_ERROR, 0)
 
-def compute_sum_slow(start: int, end: int):
+def compute_sum_slow(start: int, end: int, partials: PartialPublisher = None):
     """Calcule la somme de start à end (inclus) avec une boucle"""
     if start > end:
         return (ErrorCode.START_GREATER_THAN_END, 0)
@@ -188,6 +466,16 @@ def compute_sum_slow(start: int, end: int):
             # Vérifier l'overflow int32 pendant le calcul
             if result > 2147483647 or result < -2147483648:
                 return (ErrorCode.OVERFLOW_ERROR, 0)
+
+            # Partiel périodique, le master peut alors demander l'arrêt
+            if partials and (current & 0xFFF) == 0 and partials.due():
+                partials.publish(current - 1, result)
+                if partials.stop_requested():
+                    print(f"  > Stopped by master at {current - 1}")
+                    return (ErrorCode.STOPPED, result)
+
+        if partials:
+            partials.publish(end, result)
         
         return (ErrorCode.SUCCESS, result)
     
@@ -195,16 +483,22 @@ def compute_sum_slow(start: int, end: int):
         print(f"Error computing sum: {e}")
         return (ErrorCode.UNKNOWN_ERROR, 0)
 
+# Numéro du prochain fichier résultat de ce process
+_result_file_index = 0
+
 def create_result_file(folder: str, result: int, elapsed_ms: int) -> tuple:
     """Crée un fichier horodaté avec le résultat"""
+    global _result_file_index
     try:
         # Créer le dossier si nécessaire
         if not os.path.exists(folder):
             os.makedirs(folder)
         
-        # Nom du fichier horodaté
+        # Nom du fichier horodaté ; pid et numéro : deux requêtes dans la même ms
+        # (file enchaînée, canal de secours) ne s'écrasent pas
         timestamp = datetime.now().strftime("%Y%m%d_%H%M%S_%f")[:-3]
-        filename = f"result_{timestamp}.txt"
+        _result_file_index += 1
+        filename = f"result_{timestamp}_{os.getpid()}_{_result_file_index}.txt"
         filepath = os.path.join(folder, filename)
         
         # Écrire le résultat
@@ -230,16 +524,24 @@ def worker_loop():
     ptr = None
     
     shared_data = SharedData()
+    served_counter = 0  # requestCounter de la dernière réponse écrite
+    stats = StatsWriter()
+    last_heartbeat = time.monotonic()
     
     while True:
         try:
             # Tentative de connexion à la mémoire partagée
             if connection_state == ConnectionState.SHM_NOT_FOUND:
+                layout_loaded = load_layout(LAYOUT_FILE)
                 handle, ptr = shared_memory_exists(SHM_NAME, SHM_SIZE)
                 if handle and ptr:
                     connection_state = ConnectionState.SHM_FOUND
                     slave_state = SlaveState.IDLE
                     print("> Connected to shared memory")
+                    if layout_loaded:
+                        print(f"> Layout loaded from {LAYOUT_FILE} ({SHM_SIZE} bytes)")
+                    if not stats.block and stats.attach(SHM_NAME):
+                        print(f"> Statistics published in {SHM_NAME}{STATS_SUFFIX}")
                 else:
                     time.sleep(0.5)
                     continue
@@ -258,17 +560,46 @@ def worker_loop():
                 time.sleep(0.1)
                 continue
             
+            # Annoncer notre pid (un master relancé s'en sert pour nous retrouver)
+            if OFFSET_SLAVE_PID is not None and slave_state == SlaveState.IDLE:
+                if read_uint32(raw, OFFSET_SLAVE_PID) != os.getpid():
+                    write_uint32(ptr, OFFSET_SLAVE_PID, os.getpid())
+
+            # Annoncer les modes d'intégrité gérés : le master ne demande le CRC qu'après cet écho
+            if OFFSET_SLAVE_INTEGRITY is not None and slave_state == SlaveState.IDLE:
+                modes = IPCIntegrity.CRC32C if CRC_REQUEST_RANGE is not None else IPCIntegrity.NONE
+                if read_uint32(raw, OFFSET_SLAVE_INTEGRITY) != modes:
+                    write_uint32(ptr, OFFSET_SLAVE_INTEGRITY, modes)
+
             # Machine à états
+            # Réponse reprise par le master : flags a quitté SLAVE_FINISHED ou une nouvelle requête
+            # est publiée. Entre deux requêtes de la file, IDLE ne dure que quelques µs et
+            # échappe au poll de 10 ms : ne pas l'attendre
+            if slave_state == SlaveState.WAITING_FOR_MASTER:
+                if shared_data.flags != IPCFlags.SLAVE_FINISHED or shared_data.req_counter != served_counter:
+                    slave_state = SlaveState.IDLE
+                    print("> Back to IDLE state")
+
             if slave_state == SlaveState.IDLE:
                 if shared_data.flags == IPCFlags.MASTER_READY:
+                    # La copie précédente a pu lire les inputs avant le flag : relire
+                    # maintenant que MASTER_READY garantit qu'ils sont publiés
+                    raw = read_shared_memory(ptr, SHM_SIZE)
+                    extract_data_shared_memory(raw, shared_data)
+                    intact = request_intact(raw)
+
                     print(f"> Starting computation: sum({shared_data.start} to {shared_data.end})")
                     
                     # Indexer la réponse sur le compteur de requete
+                    served_counter = shared_data.req_counter
                     write_uint32(ptr, OFFSET_RES_COUNTER, shared_data.req_counter)
                     print("write res_counter:", shared_data.req_counter)
 
                     # Signaler qu'on commence
                     write_uint32(ptr, OFFSET_FLAGS, IPCFlags.SLAVE_STARTED)
+                    stats.set_busy(True)
+                    stats.add(STATS_REQUESTS)
+                    stats.add(STATS_BYTES_IN, OFFSET_REQ_COUNTER - OFFSET_FOLDER)
 
                     slave_state = SlaveState.PROCESSING
                     
@@ -276,7 +607,12 @@ def worker_loop():
                     start_time = time.perf_counter()
                     
                     # Faire le calcul
-                    error_code, result = compute_sum_slow(shared_data.start, shared_data.end)
+                    if intact:
+                        partials = PartialPublisher(ptr, shared_data.req_counter)
+                        error_code, result = compute_sum_slow(shared_data.start, shared_data.end, partials)
+                    else:
+                        print("  ! Request failed integrity check")
+                        error_code, result = (ErrorCode.INTEGRITY_ERROR, 0)
                     
                     # Enregistrer le timestamp de fin
                     end_time = time.perf_counter()
@@ -296,20 +632,25 @@ def worker_loop():
                     
                     # Écrire les outputs
                     write_int32(ptr, OFFSET_CODE, error_code)
-                    write_int32(ptr, OFFSET_SUM, result if error_code == ErrorCode.SUCCESS else 0)
+                    write_int32(ptr, OFFSET_SUM, result if error_code in (ErrorCode.SUCCESS, ErrorCode.STOPPED) else 0)
                     write_c_string(ptr, OFFSET_RESULT_FILE, 256, filename)
+                    write_response_crc(ptr)
                     
                     # Signaler la fin
                     write_uint32(ptr, OFFSET_FLAGS, IPCFlags.SLAVE_FINISHED)
+                    stats.add(STATS_RESPONSES)
+                    stats.add(STATS_BYTES_OUT, OFFSET_FLAGS - OFFSET_RESULT_FILE)
+                    stats.add_error(error_code)
+                    stats.set_busy(False)
                     slave_state = SlaveState.WAITING_FOR_MASTER
                     
                     print(f"> Computation complete - waiting for master ACK")
             
-            elif slave_state == SlaveState.WAITING_FOR_MASTER:
-                if shared_data.flags == IPCFlags.IDLE:
-                    slave_state = SlaveState.IDLE
-                    print("> Back to IDLE state")
-            
+            # Signe de vie pour ipc_top, même sans trafic
+            if time.monotonic() - last_heartbeat >= 1.0:
+                stats.heartbeat()
+                last_heartbeat = time.monotonic()
+
             time.sleep(0.01)  # 10ms polling
         
         except Exception as e:
@@ -327,9 +668,18 @@ def worker_loop():
                 handle = None
 
 def main():
+    global SHM_NAME, LAYOUT_FILE
+
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--shm", default=SHM_NAME, help="nom du canal de mémoire partagée")
+    args = parser.parse_args()
+    SHM_NAME = args.shm
+    LAYOUT_FILE = layout_file_for(SHM_NAME)
+
     print("=" * 50)
     print("SLAVE PROCESS STARTED")
     print(f"PID: {os.getpid()}")
+    print(f"Shared memory: {SHM_NAME}")
     print("=" * 50)
     
     # Démarrer le thread de travail
@@ -0,0 +1,390 @@
+// Faux slave pour les tests d'endurance
+// Même handshake que le SDK, mais avec des pannes injectées à la demande :
+//   hang     SLAVE_STARTED puis plus jamais SLAVE_FINISHED
+//   stale    responseCounter en retard d'une requête (INVALID_RESPONSE_COUNTER côté master)
+//   corrupt  répond puis écrase magic ; comme le SDK, ignore ensuite le segment invalide
+//   die      meurt au milieu d'une requête (après SLAVE_STARTED)
+//
+// Les pannes sont décrites par une spécification "clé=valeur,..." passée par --faults
+// ou, pour un slave lancé par le master, par la variable d'environnement FAKE_SLAVE_FAULTS :
+//   hang=0.001,stale=0.01,corrupt=0.0005,die=0.002   probabilité par requête
+//   seed=42                                          tirage reproductible (combiné au pid)
+//   work-us=200                                      durée de calcul simulée
+//   script=faults.txt                                séquence jouée en boucle, remplace les taux
+//
+// Format du script : une entrée par ligne, "<panne> [répétitions]", '#' pour commenter
+//   ok 500
+//   stale
+//   ok 200
+//   die
+
+#include "SharedData.h"
+#include "SharedMemoryMapping.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#ifndef IPC_NAME
+#define IPC_NAME "ipc_masterslave_shm"
+#endif
+
+#ifndef FAKE_SLAVE_FAULTS_ENV
+#define FAKE_SLAVE_FAULTS_ENV "FAKE_SLAVE_FAULTS"
+#endif
+
+namespace
+{
+    enum class Fault
+    {
+        None,
+        Hang,
+        Stale,
+        Corrupt,
+        Die,
+        Count
+    };
+
+    const char* faultName(Fault fault)
+    {
+        switch (fault)
+        {
+        case Fault::None:    return "ok";
+        case Fault::Hang:    return "hang";
+        case Fault::Stale:   return "stale";
+        case Fault::Corrupt: return "corrupt";
+        case Fault::Die:     return "die";
+        case Fault::Count:   break;
+        }
+        return "?";
+    }
+
+    bool parseFault(const std::string& name, Fault& fault)
+    {
+        for (int i = 0; i < static_cast<int>(Fault::Count); ++i)
+        {
+            if (name == faultName(static_cast<Fault>(i)))
+            {
+                fault = static_cast<Fault>(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Choix de la panne de chaque requête : script en boucle, sinon tirage selon les taux
+    class FaultPlan
+    {
+    public:
+        bool parse(const std::string& spec)
+        {
+            std::stringstream items(spec);
+            std::string item;
+
+            while (std::getline(items, item, ','))
+            {
+                if (item.empty())
+                    continue;
+
+                const size_t eq = item.find('=');
+                if (eq == std::string::npos)
+                    return false;
+
+                const std::string key = item.substr(0, eq);
+                const std::string value = item.substr(eq + 1);
+
+                Fault fault;
+                if (parseFault(key, fault) && fault != Fault::None)
+                    m_rates[static_cast<int>(fault)] = atof(value.c_str());
+                else if (key == "seed")
+                    m_seed = strtoul(value.c_str(), nullptr, 10);
+                else if (key == "work-us")
+                    m_workUs = atoi(value.c_str());
+                else if (key == "script")
+                {
+                    if (!loadScript(value))
+                        return false;
+                }
+                else
+                    return false;
+            }
+            return true;
+        }
+
+        void seed(uint32_t pid)
+        {
+            m_rng.seed(m_seed != 0 ? m_seed ^ (pid * 2654435761u) : std::random_device{}());
+        }
+
+        int workUs() const { return m_workUs; }
+
+        Fault next()
+        {
+            if (!m_script.empty())
+            {
+                const Fault fault = m_script[m_scriptPos];
+                m_scriptPos = (m_scriptPos + 1) % m_script.size();
+                return fault;
+            }
+
+            const double draw = m_uniform(m_rng);
+            double threshold = 0.0;
+            for (int i = 1; i < static_cast<int>(Fault::Count); ++i)
+            {
+                threshold += m_rates[i];
+                if (draw < threshold)
+                    return static_cast<Fault>(i);
+            }
+            return Fault::None;
+        }
+
+        void print() const
+        {
+            if (!m_script.empty())
+            {
+                printf("Faults: script of %zu request(s)\n", m_script.size());
+                return;
+            }
+
+            printf("Faults:");
+            for (int i = 1; i < static_cast<int>(Fault::Count); ++i)
+                printf(" %s=%g", faultName(static_cast<Fault>(i)), m_rates[i]);
+            printf("\n");
+        }
+
+    private:
+        bool loadScript(const std::string& path)
+        {
+            std::ifstream in(path);
+            if (!in)
+            {
+                printf("Cannot open fault script %s\n", path.c_str());
+                return false;
+            }
+
+            std::string line;
+            while (std::getline(in, line))
+            {
+                const size_t hash = line.find('#');
+                if (hash != std::string::npos)
+                    line.erase(hash);
+
+                std::stringstream words(line);
+                std::string name;
+                int repeat = 1;
+                if (!(words >> name))
+                    continue;
+                words >> repeat;
+
+                Fault fault;
+                if (!parseFault(name, fault) || repeat < 1)
+                {
+                    printf("Invalid fault script line: %s\n", line.c_str());
+                    return false;
+                }
+                m_script.insert(m_script.end(), static_cast<size_t>(repeat), fault);
+            }
+            return !m_script.empty();
+        }
+
+        double m_rates[static_cast<int>(Fault::Count)] = {};
+        uint32_t m_seed = 0;
+        int m_workUs = 0;
+        std::vector<Fault> m_script;
+        size_t m_scriptPos = 0;
+        std::mt19937 m_rng;
+        std::uniform_real_distribution<double> m_uniform{ 0.0, 1.0 };
+    };
+
+    struct Options
+    {
+        std::string shmName = IPC_NAME;
+        std::string faults;
+    };
+
+    std::atomic<bool> g_stop{ false };
+
+    void onSignal(int)
+    {
+        g_stop = true;
+    }
+
+    void printUsage(const char* exe)
+    {
+        printf("Usage: %s [--shm NAME] [--faults SPEC]\n", exe);
+        printf("SPEC: hang=P,stale=P,corrupt=P,die=P,seed=N,work-us=N,script=FILE (default: $%s)\n", FAKE_SLAVE_FAULTS_ENV);
+    }
+
+    bool parseOptions(int argc, char* argv[], Options& options)
+    {
+        if (const char* env = getenv(FAKE_SLAVE_FAULTS_ENV))
+            options.faults = env;
+
+        for (int i = 1; i < argc; ++i)
+        {
+            const char* arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+
+            if (strcmp(arg, "--shm") == 0 && hasValue)
+                options.shmName = argv[++i];
+            else if (strcmp(arg, "--faults") == 0 && hasValue)
+                options.faults = argv[++i];
+            else
+                return false;
+        }
+        return true;
+    }
+
+    uint32_t currentPid()
+    {
+#ifdef _WIN32
+        return static_cast<uint32_t>(_getpid());
+#else
+        return static_cast<uint32_t>(getpid());
+#endif
+    }
+
+    void compute(const SumRequest& request, SumResponse& response, int workUs)
+    {
+        if (workUs > 0)
+            std::this_thread::sleep_for(std::chrono::microseconds(workUs));
+
+        const int64_t start = request.startNumber;
+        const int64_t end = request.endNumber;
+        const int64_t sum = (end - start + 1) * (start + end) / 2;
+
+        if (start > end)
+            response.codeResult = IPCErrorCode::START_GREATER_THAN_END;
+        else if (sum > INT32_MAX || sum < INT32_MIN)
+            response.codeResult = IPCErrorCode::OVERFLOW_ERROR;
+        else
+        {
+            response.codeResult = IPCErrorCode::SUCCESS;
+            response.sumResult = static_cast<int32_t>(sum);
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    FaultPlan plan;
+    if (!parseOptions(argc, argv, options) || !plan.parse(options.faults))
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    const uint32_t pid = currentPid();
+    plan.seed(pid);
+
+    printf("FAKE SLAVE %u on %s\n", pid, options.shmName.c_str());
+    plan.print();
+    fflush(stdout);
+
+    SharedMemoryMapping mapping;
+    while (!mapping.open(options.shmName, SumChannel::kSize))
+    {
+        if (g_stop)
+            return 0;
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    }
+
+    SumChannel channel(mapping.data());
+    channel.setSlavePid(pid);
+    channel.setSlaveIntegrity(IPCIntegrity::CRC32C);
+
+    bool waitingForMaster = false;
+    uint32_t servedCounter = 0;
+
+    while (!g_stop)
+    {
+        // Comme le SDK : un segment sans magic valide n'est pas servi
+        if (!channel.isValid())
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        const uint32_t flags = channel.flags();
+
+        if (!waitingForMaster && channel.slavePid() != pid)
+            channel.setSlavePid(pid);
+        if (!waitingForMaster && channel.slaveIntegrity() != IPCIntegrity::CRC32C)
+            channel.setSlaveIntegrity(IPCIntegrity::CRC32C);
+
+        // Comme le SDK : ne pas attendre un IDLE qui peut durer quelques µs
+        if (waitingForMaster && channel.responseCollected(servedCounter))
+            waitingForMaster = false;
+
+        if (waitingForMaster)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        if (flags != IPCFlags::MASTER_READY)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        SumRequest request;
+        uint32_t requestCounter = 0;
+        const bool intact = channel.readRequest(request, requestCounter);
+        const Fault fault = plan.next();
+        servedCounter = requestCounter;
+
+        if (fault != Fault::None)
+        {
+            printf("! %s on request %u\n", faultName(fault), requestCounter);
+            fflush(stdout);
+        }
+
+        // Réponse indexée sur une requête précédente
+        channel.acceptRequest(fault == Fault::Stale ? requestCounter - 1 : requestCounter);
+
+        if (fault == Fault::Die)
+            _Exit(3);
+
+        if (fault == Fault::Hang)
+        {
+            while (!g_stop)
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            break;
+        }
+
+        SumResponse response{};
+        if (intact)
+            compute(request, response, plan.workUs());
+        else
+            response.codeResult = IPCErrorCode::INTEGRITY_ERROR;
+
+        channel.postResponse(response);
+        waitingForMaster = true;
+
+        if (fault == Fault::Corrupt)
+            channel.segment()->magic = ~IPC_MAGIC;
+    }
+
+    return 0;
+}
@@ -0,0 +1,352 @@
+#include "MasterBench.h"
+#include "AppModel.h"
+#include "AppController.h"
+#include "MainWindow.h"
+#include "ResultFileModel.h"
+
+#include <QtTest/QtTest>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace
+{
+    // --- Implémentations d'origine, gardées comme point de comparaison ---
+
+    // Boucle d'AppModel::onScanProcessFinished de la baseline, prédicat compris
+    bool legacyFindSlaveInScan(const QString& output, const QString& scriptName, int& pidOut)
+    {
+        bool found = false;
+        int pid = -1;
+
+        QStringList lines = output.split('\n');
+
+        for (const QString& line : lines)
+        {
+            if (line.contains("python", Qt::CaseInsensitive) &&
+                line.contains(scriptName, Qt::CaseInsensitive))
+            {
+                found = true;
+
+                QString colPid = line.split(',')[0];
+                colPid = colPid.mid(1, colPid.length() - 2);
+                pid = colPid.toInt();
+
+                break;
+            }
+        }
+
+        pidOut = pid;
+        return found;
+    }
+
+    bool legacyExtractDuration(const QString& content, quint64& elapsedOut)
+    {
+        QStringList lines = content.split("\n");
+        bool ok = false;
+
+        for (const auto& line : lines)
+        {
+            if (line.startsWith("Duration:"))
+            {
+                QString value = line.right(line.length() - 10);
+
+                int v = value.toInt(&ok);
+                if (ok)
+                    elapsedOut = v;
+            }
+        }
+        return ok;
+    }
+
+    void legacyFolderCopy(SumRequest& request, const QString& folder)
+    {
+        QByteArray folderBytes = folder.toUtf8();
+        strncpy_s(request.resultsFolderPath, sizeof(request.resultsFolderPath), folderBytes.constData(), _TRUNCATE);
+    }
+
+    // Sortie typique du scan PowerShell : en-tête puis une ligne par process python / NativeSlave
+    QByteArray makeScanOutput(int processCount)
+    {
+        QByteArray csv = "\"ProcessId\",\"Name\",\"CommandLine\"\r\n";
+        for (int i = 0; i < processCount; ++i)
+        {
+            csv += "\"" + QByteArray::number(10000 + i) + "\",\"python.exe\","
+                "\"C:\\Python312\\python.exe -m some_tool --worker " + QByteArray::number(i) + "\"\r\n";
+        }
+        csv += "\"4242\",\"python.exe\",\"C:\\Python312\\python.exe -u C:\\work\\Slave\\slave.py --shm ipc_masterslave_shm\"\r\n";
+        return csv;
+    }
+
+    // Fichier de résultat du slave, éventuellement suivi de lignes de détail
+    QByteArray makeResultFile(int extraLines)
+    {
+        QByteArray content = "Result: 5050\nDuration: 1234\n";
+        for (int i = 0; i < extraLines; ++i)
+            content += "Partial " + QByteArray::number(i) + ": " + QByteArray::number(i * 37) + "\n";
+        return content;
+    }
+
+    // Faux slave : répond à chaque MASTER_READY par la somme demandée, en attente active
+    class FakeSlave
+    {
+    public:
+        explicit FakeSlave(void* mapping) :
+            m_channel(mapping)
+        {
+            m_thread = std::thread([this] { run(); });
+        }
+
+        ~FakeSlave()
+        {
+            m_stop = true;
+            m_thread.join();
+        }
+
+    private:
+        void run()
+        {
+            while (!m_stop)
+            {
+                if (m_channel.flags() != IPCFlags::MASTER_READY)
+                    continue;
+
+                SumRequest request;
+                uint32_t requestCounter = 0;
+                SumResponse response = {};
+
+                if (!m_channel.readRequest(request, requestCounter))
+                {
+                    response.codeResult = IPCErrorCode::INTEGRITY_ERROR;
+                    m_channel.acceptRequest(requestCounter);
+                    m_channel.postResponse(response);
+                    continue;
+                }
+
+                m_channel.acceptRequest(requestCounter);
+
+                const qint64 count = qint64(request.endNumber) - request.startNumber + 1;
+                response.codeResult = IPCErrorCode::SUCCESS;
+                response.sumResult = static_cast<int32_t>((qint64(request.startNumber) + request.endNumber) * count / 2);
+                strcpy_s(response.resultFileName, sizeof(response.resultFileName), "result_bench.txt");
+
+                m_channel.postResponse(response);
+            }
+        }
+
+        SumChannel m_channel;
+        std::atomic<bool> m_stop{ false };
+        std::thread m_thread;
+    };
+}
+
+void MasterBench::initTestCase()
+{
+    m_scanOutput = makeScanOutput(40);
+    m_resultFile = makeResultFile(2000);
+}
+
+void MasterBench::scanParse_data()
+{
+    QTest::addColumn<bool>("legacy");
+
+    QTest::newRow("legacy") << true;
+    QTest::newRow("current") << false;
+}
+
+void MasterBench::scanParse()
+{
+    QFETCH(bool, legacy);
+
+    const QString scriptName = "slave.py";
+    const QByteArray scriptLatin1 = scriptName.toLatin1();
+
+    int pid = -1;
+    bool found = false;
+
+    // Le QString de la version d'origine faisait partie de son coût (readAllStandardOutput -> QString,
+    // conversion implicite donc UTF-8)
+    if (legacy)
+    {
+        QBENCHMARK
+        {
+            found = legacyFindSlaveInScan(QString::fromUtf8(m_scanOutput), scriptName, pid);
+        }
+    }
+    else
+    {
+        QBENCHMARK
+        {
+            found = AppModel::findSlaveInScan(m_scanOutput, QLatin1StringView(scriptLatin1), pid);
+        }
+    }
+
+    QVERIFY(found);
+    QCOMPARE(pid, 4242);
+}
+
+void MasterBench::extractDuration_data()
+{
+    QTest::addColumn<bool>("legacy");
+    QTest::addColumn<int>("extraLines");
+
+    QTest::newRow("legacy/small") << true << 0;
+    QTest::newRow("current/small") << false << 0;
+    QTest::newRow("legacy/2000 lines") << true << 2000;
+    QTest::newRow("current/2000 lines") << false << 2000;
+}
+
+void MasterBench::extractDuration()
+{
+    QFETCH(bool, legacy);
+    QFETCH(int, extraLines);
+
+    const QByteArray content = extraLines == 0 ? makeResultFile(0) : m_resultFile;
+
+    quint64 elapsed = 0;
+    bool found = false;
+
+    if (legacy)
+    {
+        QBENCHMARK
+        {
+            found = legacyExtractDuration(QString::fromUtf8(content), elapsed);
+        }
+    }
+    else
+    {
+        QBENCHMARK
+        {
+            found = ResultFileModel::extractDuration(content.constData(), content.size(), elapsed);
+        }
+    }
+
+    QVERIFY(found);
+    QCOMPARE(elapsed, quint64(1234));
+}
+
+void MasterBench::folderCopy_data()
+{
+    QTest::addColumn<bool>("legacy");
+    QTest::addColumn<QString>("folder");
+
+    const QString shortFolder = "C:/work/outputs";
+    const QString longFolder = "C:/work/" + QString(300, QChar(0x00E9));  // tronqué, multi-octets
+
+    QTest::newRow("legacy/short") << true << shortFolder;
+    QTest::newRow("current/short") << false << shortFolder;
+    QTest::newRow("legacy/long") << true << longFolder;
+    QTest::newRow("current/long") << false << longFolder;
+}
+
+void MasterBench::folderCopy()
+{
+    QFETCH(bool, legacy);
+    QFETCH(QString, folder);
+
+    SumRequest request = {};
+
+    // AppModel encode le dossier une fois dans setFolder, pas à chaque requête
+    const QByteArray folderUtf8 = folder.toUtf8();
+
+    if (legacy)
+    {
+        QBENCHMARK
+        {
+            legacyFolderCopy(request, folder);
+        }
+    }
+    else
+    {
+        QBENCHMARK
+        {
+            AppModel::copyFolderPath(request, folderUtf8);
+        }
+    }
+
+    // Les deux variantes produisent exactement les mêmes octets
+    SumRequest reference = {};
+    legacyFolderCopy(reference, folder);
+    QCOMPARE(QByteArray(request.resultsFolderPath), QByteArray(reference.resultsFolderPath));
+}
+
+void MasterBench::signalFanOut_data()
+{
+    QTest::addColumn<int>("signal");
+
+    QTest::newRow("telemetryChanged") << 0;
+    QTest::newRow("outputsChanged") << 1;
+    QTest::newRow("processInfoChanged") << 2;
+    QTest::newRow("inputsChanged") << 3;
+}
+
+void MasterBench::signalFanOut()
+{
+    QFETCH(int, signal);
+
+    // Modèle sans mémoire partagée ni slave : seul le chemin signal -> slot -> widgets est mesuré
+    AppModel model(nullptr, false);
+    MainWindow view;
+    AppController controller(&model, &view);
+
+    QBENCHMARK
+    {
+        switch (signal)
+        {
+        case 0: emit model.telemetryChanged(); break;
+        case 1: emit model.outputsChanged(); break;
+        case 2: emit model.processInfoChanged(); break;
+        case 3: emit model.inputsChanged(); break;
+        }
+    }
+}
+
+void MasterBench::handshake_data()
+{
+    QTest::addColumn<quint32>("integrity");
+
+    QTest::newRow("no integrity") << IPCIntegrity::NONE;
+    QTest::newRow("crc32c") << IPCIntegrity::CRC32C;
+}
+
+void MasterBench::handshake()
+{
+    QFETCH(quint32, integrity);
+
+    // Même layout que le mapping nommé, sur le tas : pas de dépendance à un vrai slave
+    std::unique_ptr<uint64_t[]> memory(new uint64_t[(SumChannel::kSize + 7) / 8]);
+    SumChannel channel(memory.get());
+    channel.initialize();
+
+    FakeSlave slave(memory.get());
+
+    SumRequest request = {};
+    AppModel::copyFolderPath(request, "C:/work/outputs");
+    request.startNumber = 1;
+    request.endNumber = 100;
+
+    uint32_t requestCounter = 0;
+    SumResponse response = {};
+    uint32_t responseCounter = 0;
+    bool intact = false;
+
+    // Un aller-retour : postRequest, attente de SLAVE_FINISHED, lecture, retour à IDLE
+    QBENCHMARK
+    {
+        channel.postRequest(request, ++requestCounter, integrity);
+
+        while (channel.flags() != IPCFlags::SLAVE_FINISHED)
+            ;
+
+        intact = channel.readResponse(response, responseCounter);
+        channel.setFlags(IPCFlags::IDLE);
+    }
+
+    QVERIFY(intact);
+    QCOMPARE(responseCounter, requestCounter);
+    QCOMPARE(response.codeResult, IPCErrorCode::SUCCESS);
+    QCOMPARE(response.sumResult, 5050);
+}
+
+QTEST_MAIN(MasterBench)
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <QObject>
+
+// Microbenchmarks QBENCHMARK des chemins chauds du master
+// Chaque mesure existe en deux variantes : "legacy" (implémentation d'origine,
+// recopiée ici comme référence) et l'implémentation actuelle d'AppModel
+//
+// Pour des chiffres stables : build Release, machine au repos, et
+//   MasterBench.exe -median 9 -minimumvalue 100
+// -tickcounter mesure en cycles CPU plutôt qu'en temps mural
+class MasterBench : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    // onScanProcessFinished : recherche du slave dans la sortie CSV
+    void scanParse_data();
+    void scanParse();
+
+    // tryExractSlaveElapsedFromFile : extraction de "Duration:"
+    void extractDuration_data();
+    void extractDuration();
+
+    // Copie du dossier de résultats dans la requête
+    void folderCopy_data();
+    void folderCopy();
+
+    // Signaux modèle -> AppController -> MainWindow
+    void signalFanOut_data();
+    void signalFanOut();
+
+    // Aller-retour complet du handshake contre un faux slave dans le process
+    void handshake_data();
+    void handshake();
+
+private:
+    QByteArray m_scanOutput;
+    QByteArray m_resultFile;
+};
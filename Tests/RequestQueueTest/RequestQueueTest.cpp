@@ -0,0 +1,206 @@
+#include "RequestQueueTest.h"
+#include "RequestQueue.h"
+
+#include <QtTest/QtTest>
+
+#include <atomic>
+#include <thread>
+
+namespace
+{
+    QueuedRequest makeRequest(quint64 id, int priority)
+    {
+        QueuedRequest request;
+        request.id = id;
+        request.priority = priority;
+        request.request.startNumber = static_cast<int32_t>(id);
+        return request;
+    }
+
+    QList<quint64> drain(RequestQueue& queue)
+    {
+        QList<quint64> ids;
+        QueuedRequest out;
+        while (queue.pop(out))
+            ids << out.id;
+        return ids;
+    }
+
+    // Laisse au thread le temps d'entrer dans push
+    constexpr int BLOCK_SETTLE_MS = 50;
+}
+
+void RequestQueueTest::popOrder()
+{
+    RequestQueue queue(8);
+    QCOMPARE(queue.push(makeRequest(1, 0)), RequestQueue::PushResult::Queued);
+    QCOMPARE(queue.push(makeRequest(2, 5)), RequestQueue::PushResult::Queued);
+    QCOMPARE(queue.push(makeRequest(3, 0)), RequestQueue::PushResult::Queued);
+    QCOMPARE(queue.push(makeRequest(4, 5)), RequestQueue::PushResult::Queued);
+    QCOMPARE(queue.push(makeRequest(5, -1)), RequestQueue::PushResult::Queued);
+    QCOMPARE(queue.size(), 5);
+
+    QCOMPARE(drain(queue), (QList<quint64>{ 2, 4, 1, 3, 5 }));
+    QVERIFY(queue.isEmpty());
+}
+
+void RequestQueueTest::rejectWhenFull()
+{
+    RequestQueue queue(2, RequestQueue::OverflowPolicy::Reject);
+    QCOMPARE(queue.push(makeRequest(1, 0)), RequestQueue::PushResult::Queued);
+    QCOMPARE(queue.push(makeRequest(2, 0)), RequestQueue::PushResult::Queued);
+
+    // Même plus prioritaire, la nouvelle requête est refusée
+    QCOMPARE(queue.push(makeRequest(3, 9)), RequestQueue::PushResult::Rejected);
+    QCOMPARE(queue.size(), 2);
+    QCOMPARE(drain(queue), (QList<quint64>{ 1, 2 }));
+}
+
+void RequestQueueTest::dropOldest_data()
+{
+    QTest::addColumn<int>("priority");
+    QTest::addColumn<quint64>("droppedId");
+    QTest::addColumn<QList<quint64>>("remaining");
+
+    // File : 1 (p1), 2 (p0), 3 (p0), puis la requête 4
+    QTest::newRow("same as lowest") << 0 << quint64(2) << QList<quint64>{ 1, 3, 4 };
+    QTest::newRow("between levels") << 1 << quint64(2) << QList<quint64>{ 1, 4, 3 };
+    QTest::newRow("highest") << 2 << quint64(2) << QList<quint64>{ 4, 1, 3 };
+}
+
+void RequestQueueTest::dropOldest()
+{
+    QFETCH(int, priority);
+    QFETCH(quint64, droppedId);
+    QFETCH(QList<quint64>, remaining);
+
+    RequestQueue queue(3, RequestQueue::OverflowPolicy::DropOldest);
+    queue.push(makeRequest(1, 1));
+    queue.push(makeRequest(2, 0));
+    queue.push(makeRequest(3, 0));
+
+    QueuedRequest dropped;
+    QCOMPARE(queue.push(makeRequest(4, priority), &dropped), RequestQueue::PushResult::QueuedDroppedOldest);
+    QCOMPARE(dropped.id, droppedId);
+    QCOMPARE(queue.size(), 3);
+    QCOMPARE(drain(queue), remaining);
+}
+
+void RequestQueueTest::dropOldestRejectsLowerPriority()
+{
+    RequestQueue queue(2, RequestQueue::OverflowPolicy::DropOldest);
+    queue.push(makeRequest(1, 1));
+    queue.push(makeRequest(2, 1));
+
+    QueuedRequest dropped;
+    QCOMPARE(queue.push(makeRequest(3, 0), &dropped), RequestQueue::PushResult::Rejected);
+    QCOMPARE(dropped.id, quint64(0));
+    QCOMPARE(drain(queue), (QList<quint64>{ 1, 2 }));
+}
+
+void RequestQueueTest::removeQueued()
+{
+    RequestQueue queue(8);
+    queue.push(makeRequest(1, 0));
+    queue.push(makeRequest(2, 1));
+    queue.push(makeRequest(3, 0));
+
+    QVERIFY(queue.remove(2));
+    QVERIFY(queue.remove(1));
+    QVERIFY(!queue.remove(2));
+    QVERIFY(!queue.remove(42));
+    QCOMPARE(queue.size(), 1);
+    QCOMPARE(drain(queue), (QList<quint64>{ 3 }));
+}
+
+void RequestQueueTest::blockUntilPop()
+{
+    RequestQueue queue(1, RequestQueue::OverflowPolicy::Block);
+    queue.push(makeRequest(1, 0));
+
+    std::atomic<bool> done{ false };
+    RequestQueue::PushResult result = RequestQueue::PushResult::Rejected;
+    std::thread producer([&]()
+    {
+        result = queue.push(makeRequest(2, 0));
+        done = true;
+    });
+
+    // Vérifications après join : un QVERIFY qui échoue ne doit pas quitter avec le thread vivant
+    QTest::qWait(BLOCK_SETTLE_MS);
+    const bool blocked = !done;
+    const int sizeWhileBlocked = queue.size();
+
+    QueuedRequest out;
+    const bool popped = queue.pop(out);
+
+    producer.join();
+    QVERIFY(blocked);
+    QCOMPARE(sizeWhileBlocked, 1);
+    QVERIFY(popped);
+    QCOMPARE(out.id, quint64(1));
+    QCOMPARE(result, RequestQueue::PushResult::Queued);
+    QCOMPARE(drain(queue), (QList<quint64>{ 2 }));
+}
+
+void RequestQueueTest::blockWithoutWaiting()
+{
+    RequestQueue queue(1, RequestQueue::OverflowPolicy::Block);
+    QCOMPARE(queue.push(makeRequest(1, 0), nullptr, false), RequestQueue::PushResult::Queued);
+
+    // Appel sur le thread du test : un push qui attendrait ne reviendrait jamais
+    QCOMPARE(queue.push(makeRequest(2, 9), nullptr, false), RequestQueue::PushResult::Rejected);
+    QCOMPARE(queue.size(), 1);
+
+    QueuedRequest out;
+    QVERIFY(queue.pop(out));
+    QCOMPARE(queue.push(makeRequest(3, 0), nullptr, false), RequestQueue::PushResult::Queued);
+    QCOMPARE(drain(queue), (QList<quint64>{ 3 }));
+}
+
+void RequestQueueTest::blockThenPolicyChange_data()
+{
+    QTest::addColumn<int>("policy");
+    QTest::addColumn<int>("priority");
+    QTest::addColumn<int>("expected");
+    QTest::addColumn<QList<quint64>>("remaining");
+
+    // File : 1 (p1), puis la requête 2 bloquée
+    QTest::newRow("to Reject") << int(RequestQueue::OverflowPolicy::Reject) << 2
+        << int(RequestQueue::PushResult::Rejected) << QList<quint64>{ 1 };
+    QTest::newRow("to DropOldest, higher") << int(RequestQueue::OverflowPolicy::DropOldest) << 2
+        << int(RequestQueue::PushResult::QueuedDroppedOldest) << QList<quint64>{ 2 };
+    QTest::newRow("to DropOldest, lower") << int(RequestQueue::OverflowPolicy::DropOldest) << 0
+        << int(RequestQueue::PushResult::Rejected) << QList<quint64>{ 1 };
+}
+
+void RequestQueueTest::blockThenPolicyChange()
+{
+    QFETCH(int, policy);
+    QFETCH(int, priority);
+    QFETCH(int, expected);
+    QFETCH(QList<quint64>, remaining);
+
+    RequestQueue queue(1, RequestQueue::OverflowPolicy::Block);
+    queue.push(makeRequest(1, 1));
+
+    std::atomic<bool> done{ false };
+    RequestQueue::PushResult result = RequestQueue::PushResult::Queued;
+    std::thread producer([&]()
+    {
+        result = queue.push(makeRequest(2, priority));
+        done = true;
+    });
+
+    QTest::qWait(BLOCK_SETTLE_MS);
+    const bool blocked = !done;
+
+    queue.setPolicy(static_cast<RequestQueue::OverflowPolicy>(policy));
+    producer.join();
+
+    QVERIFY(blocked);
+    QCOMPARE(int(result), expected);
+    QCOMPARE(drain(queue), remaining);
+}
+
+QTEST_GUILESS_MAIN(RequestQueueTest)
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <QObject>
+
+// Tests unitaires de RequestQueue : ordre de sortie et politiques de débordement
+class RequestQueueTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Priorité décroissante, puis FIFO à priorité égale
+    void popOrder();
+
+    void rejectWhenFull();
+
+    // Abandon de la plus ancienne des moins prioritaires
+    void dropOldest_data();
+    void dropOldest();
+
+    // Nouvelle requête moins prioritaire que toute la file : refusée, la file est intacte
+    void dropOldestRejectsLowerPriority();
+
+    // Retrait d'une requête en attente (annulation d'un balayage)
+    void removeQueued();
+
+    // push bloqué jusqu'à ce qu'un pop libère une place
+    void blockUntilPop();
+
+    // push sans attente (thread du modèle) : refus immédiat si pleine, insertion sinon
+    void blockWithoutWaiting();
+
+    // push bloqué puis politique changée pendant l'attente
+    void blockThenPolicyChange_data();
+    void blockThenPolicyChange();
+};
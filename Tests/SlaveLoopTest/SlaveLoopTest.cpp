@@ -0,0 +1,231 @@
+#include "SlaveLoopTest.h"
+#include "SharedData.h"
+#include "IpcSlave.h"
+
+#include <QtTest/QtTest>
+#include <QDir>
+#include <QFileInfo>
+#include <QProcess>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+
+#include <atomic>
+#include <functional>
+#include <thread>
+
+#include <windows.h>
+
+namespace
+{
+    constexpr int REQUEST_COUNT = 8;
+
+    // Le master accorde 30 s au démarrage : ici un raté doit se voir vite
+    constexpr int START_TIMEOUT_MS = 3000;
+    constexpr int FINISH_TIMEOUT_MS = 10000;
+    constexpr int CONNECT_TIMEOUT_MS = 10000;
+
+    // Segment nommé créé comme le fait AppModel::createSharedMemory
+    class NamedSegment
+    {
+    public:
+        explicit NamedSegment(const QString& name)
+        {
+            const QString fullName = "Local\\" + name;
+            m_handle = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                0, SumChannel::kSize, reinterpret_cast<LPCWSTR>(fullName.utf16()));
+            if (m_handle)
+                m_data = MapViewOfFile(m_handle, FILE_MAP_ALL_ACCESS, 0, 0, SumChannel::kSize);
+            if (m_data)
+                SumChannel(m_data).initialize();
+        }
+
+        ~NamedSegment()
+        {
+            if (m_data)
+                UnmapViewOfFile(m_data);
+            if (m_handle)
+                CloseHandle(m_handle);
+        }
+
+        void* data() const { return m_data; }
+
+    private:
+        HANDLE m_handle = nullptr;
+        void* m_data = nullptr;
+    };
+
+    QString segmentName(const char* suffix)
+    {
+        return QString("ipc_slaveloop_%1_%2").arg(suffix).arg(QCoreApplication::applicationPid());
+    }
+
+    bool waitFor(const std::function<bool()>& condition, int timeoutMs)
+    {
+        QElapsedTimer timer;
+        timer.start();
+        while (!condition())
+        {
+            if (timer.elapsed() >= timeoutMs)
+                return false;
+            QThread::msleep(1);
+        }
+        return true;
+    }
+
+    // Attache du slave : pid publié et, si le test demande un contrôle, mode annoncé
+    // (le master ne demande le CRC qu'après cette annonce)
+    bool waitForSlave(const SumChannel& channel, uint32_t integrity)
+    {
+        return waitFor([&]()
+        {
+            return channel.slavePid() != 0 && channel.negotiatedIntegrity(integrity) == integrity;
+        }, CONNECT_TIMEOUT_MS);
+    }
+
+    // Même séquence que WorkerThread::run suivi de drainQueue : IDLE puis requête suivante
+    // sans délai. Renvoie une description de la première erreur, vide si tout est servi
+    QString runBackToBack(SumChannel& channel, uint32_t integrity, const QByteArray& folder)
+    {
+        for (uint32_t counter = 1; counter <= REQUEST_COUNT; ++counter)
+        {
+            SumRequest request{};
+            qstrncpy(request.resultsFolderPath, folder.constData(), sizeof(request.resultsFolderPath));
+            request.startNumber = 1;
+            request.endNumber = static_cast<int32_t>(100 * counter);
+
+            channel.postRequest(request, counter, integrity);
+
+            if (!waitFor([&]() { return channel.flags() != IPCFlags::MASTER_READY; }, START_TIMEOUT_MS))
+                return QString("request %1 not taken within %2 ms").arg(counter).arg(START_TIMEOUT_MS);
+
+            if (!waitFor([&]() { return channel.flags() == IPCFlags::SLAVE_FINISHED; }, FINISH_TIMEOUT_MS))
+                return QString("request %1 not finished within %2 ms").arg(counter).arg(FINISH_TIMEOUT_MS);
+
+            SumResponse response{};
+            uint32_t responseCounter = 0;
+            if (!channel.readResponse(response, responseCounter))
+                return QString("request %1 failed the integrity check").arg(counter);
+
+            const int64_t end = request.endNumber;
+            if (responseCounter != counter || response.codeResult != IPCErrorCode::SUCCESS ||
+                response.sumResult != end * (end + 1) / 2)
+            {
+                return QString("request %1: counter %2, code %3, sum %4")
+                    .arg(counter).arg(responseCounter).arg(response.codeResult).arg(response.sumResult);
+            }
+
+            channel.setFlags(IPCFlags::IDLE);
+        }
+        return QString();
+    }
+
+    QString findSlaveScript()
+    {
+        const QStringList dirs = {
+            QCoreApplication::applicationDirPath(),
+            QDir::currentPath() + "/../Slave",
+            QDir::currentPath() + "/../../Slave",
+            QCoreApplication::applicationDirPath() + "/../../../Slave"
+        };
+        for (const QString& dir : dirs)
+        {
+            const QFileInfo info(QDir(dir).filePath("slave.py"));
+            if (info.exists())
+                return info.absoluteFilePath();
+        }
+        return QString();
+    }
+}
+
+void SlaveLoopTest::queuedRequestsSdkSlave_data()
+{
+    QTest::addColumn<int>("pollUs");
+    QTest::addColumn<quint32>("integrity");
+
+    QTest::newRow("poll 10 ms") << 10000 << IPCIntegrity::NONE;
+    QTest::newRow("poll 10 ms, crc32c") << 10000 << IPCIntegrity::CRC32C;
+    QTest::newRow("busy wait") << 0 << IPCIntegrity::NONE;
+}
+
+void SlaveLoopTest::queuedRequestsSdkSlave()
+{
+    QFETCH(int, pollUs);
+    QFETCH(quint32, integrity);
+
+    const QString name = segmentName("sdk");
+    NamedSegment segment(name);
+    QVERIFY(segment.data());
+    SumChannel channel(segment.data());
+
+    IpcSlave<SumRequest, SumResponse> slave(name.toStdString());
+    std::atomic<bool> stop{ false };
+    std::thread thread([&]()
+    {
+        slave.run([](const SumRequest& request, SumResponse& response)
+        {
+            const int64_t count = int64_t(request.endNumber) - request.startNumber + 1;
+            response.codeResult = IPCErrorCode::SUCCESS;
+            response.sumResult = static_cast<int32_t>((int64_t(request.startNumber) + request.endNumber) * count / 2);
+        }, stop, std::chrono::microseconds(pollUs));
+    });
+
+    // Vérifications après join : un QVERIFY qui échoue ne doit pas quitter avec le thread vivant
+    const bool connected = waitForSlave(channel, integrity);
+    const QString error = connected ? runBackToBack(channel, integrity, QByteArray()) : QString();
+
+    stop = true;
+    thread.join();
+
+    QVERIFY2(connected, "SDK slave did not attach to the segment");
+    QVERIFY2(error.isEmpty(), qPrintable(error));
+    QCOMPARE(slave.servedRequests(), uint64_t(REQUEST_COUNT));
+}
+
+void SlaveLoopTest::queuedRequestsPythonSlave_data()
+{
+    QTest::addColumn<quint32>("integrity");
+
+    QTest::newRow("no integrity") << IPCIntegrity::NONE;
+    QTest::newRow("crc32c") << IPCIntegrity::CRC32C;
+}
+
+void SlaveLoopTest::queuedRequestsPythonSlave()
+{
+    QFETCH(quint32, integrity);
+
+    const QString python = QStandardPaths::findExecutable("python");
+    const QString script = findSlaveScript();
+    if (python.isEmpty() || script.isEmpty())
+        QSKIP("python or slave.py not found");
+
+    const QString name = segmentName("py");
+    NamedSegment segment(name);
+    QVERIFY(segment.data());
+    SumChannel channel(segment.data());
+
+    // Descripteur de layout, comme AppModel::writeLayoutDescriptor
+    QFile layout(QDir::tempPath() + "/" + name + ".layout.json");
+    QVERIFY(layout.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text));
+    layout.write(QByteArray::fromStdString(SumChannel::layoutJson(name.toLatin1().constData())));
+    layout.close();
+
+    QTemporaryDir results;
+    QVERIFY(results.isValid());
+
+    QProcess slave;
+    slave.setProcessChannelMode(QProcess::ForwardedChannels);
+    slave.start(python, QStringList() << "-u" << script << "--shm" << name);
+    QVERIFY(slave.waitForStarted());
+
+    const bool connected = waitForSlave(channel, integrity);
+    const QString error = connected ? runBackToBack(channel, integrity, results.path().toUtf8()) : QString();
+
+    slave.kill();
+    slave.waitForFinished();
+    layout.remove();
+
+    QVERIFY2(connected, "slave.py did not attach to the segment");
+    QVERIFY2(error.isEmpty(), qPrintable(error));
+}
+
+QTEST_GUILESS_MAIN(SlaveLoopTest)
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <QObject>
+
+// Requêtes de la file enchaînées contre les vraies boucles des slaves
+// Le master repasse à IDLE puis publie la requête suivante dans la foulée (drainQueue) :
+// chaque slave doit la prendre sans avoir vu ce IDLE de quelques µs
+class SlaveLoopTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // IpcSlave::run du SDK (NativeSlave), poll espacé comme slave.py ou attente active
+    void queuedRequestsSdkSlave_data();
+    void queuedRequestsSdkSlave();
+
+    // slave.py lancé comme le ferait le superviseur (ignoré sans python)
+    void queuedRequestsPythonSlave_data();
+    void queuedRequestsPythonSlave();
+};
@@ -0,0 +1,523 @@
+// Test d'endurance du master face à des slaves défaillants
+// Fait tourner un vrai AppModel (file, superviseur, bascule sur standby) contre
+// des FakeSlave qui injectent des pannes, et mesure pendant des heures :
+//   - le débit soutenu et la latence bout en bout des requêtes
+//   - le temps de retour à une réponse correcte après chaque panne
+//   - les états bloqués : aucune réponse correcte depuis --stuck-ms alors que
+//     des requêtes attendent, avec l'état MasterState observé à ce moment
+//
+// Un slave muet (hang) doit être relancé par le master lui-même après --completion-timeout-ms.
+// Un état bloqué restant est débloqué en tuant le slave actif (ce que ferait un opérateur),
+// sauf avec --no-kill. Code de sortie 2 si au moins un état bloqué a été vu.
+//
+// Exemple : SoakTest.exe --minutes 240 --faults hang=0.0002,stale=0.002,corrupt=0.0002,die=0.001
+
+#include "AppModel.h"
+#include "SharedData.h"
+#include "SharedMemoryMapping.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QHash>
+#include <QMap>
+#include <QTimer>
+#include <QVector>
+
+#include <math.h>
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#endif
+
+namespace
+{
+    struct Options
+    {
+        qint64 durationMs = 60 * 60 * 1000;
+        QString faults = "hang=0.0002,stale=0.002,corrupt=0.0002,die=0.001";
+        QString slave;
+        int depth = 4;              // requêtes maintenues dans la file du master
+        int end = 1000;
+        qint64 stuckMs = 45000;     // au-delà des timeouts du worker : le master doit se débloquer seul
+        int completionTimeoutMs = 20000;
+        qint64 reportMs = 60000;
+        bool kill = true;
+        bool integrity = true;
+        bool verbose = false;
+    };
+
+    // Histogramme à pas géométriques (10 %) : mémoire constante sur des heures de test
+    class Histogram
+    {
+    public:
+        void add(qint64 us)
+        {
+            const int bucket = us <= 1 ? 0 : qMin(BUCKETS - 1, static_cast<int>(log(static_cast<double>(us)) / log(RATIO)) + 1);
+            m_buckets[bucket]++;
+            m_count++;
+            m_max = qMax(m_max, us);
+        }
+
+        void clear()
+        {
+            *this = Histogram();
+        }
+
+        quint64 count() const { return m_count; }
+        qint64 max() const { return m_max; }
+
+        // Borne haute du seau contenant le quantile q
+        qint64 percentile(double q) const
+        {
+            if (m_count == 0)
+                return 0;
+
+            const quint64 rank = static_cast<quint64>(ceil(q * m_count));
+            quint64 seen = 0;
+            for (int i = 0; i < BUCKETS; ++i)
+            {
+                seen += m_buckets[i];
+                if (seen >= rank)
+                    return qMin(m_max, static_cast<qint64>(pow(RATIO, i)));
+            }
+            return m_max;
+        }
+
+    private:
+        static constexpr int BUCKETS = 256;
+        static constexpr double RATIO = 1.1;
+
+        quint64 m_buckets[BUCKETS] = {};
+        quint64 m_count = 0;
+        qint64 m_max = 0;
+    };
+
+    QString formatUs(qint64 us)
+    {
+        if (us >= 1000000)
+            return QString::number(us / 1e6, 'f', 2) + " s";
+        if (us >= 1000)
+            return QString::number(us / 1e3, 'f', 2) + " ms";
+        return QString::number(us) + " us";
+    }
+
+    QString formatHistogram(const Histogram& histogram)
+    {
+        if (histogram.count() == 0)
+            return "-";
+        return QString("p50 %1  p99 %2  max %3")
+            .arg(formatUs(histogram.percentile(0.50)), formatUs(histogram.percentile(0.99)), formatUs(histogram.max()));
+    }
+
+    // Segment d'un canal, ouvert en lecture seule pour voir un magic écrasé
+    struct SegmentWatch
+    {
+        std::string name;
+        SharedMemoryMapping mapping;
+        bool corrupt = false;
+        qint64 corruptSince = 0;
+    };
+
+    class SoakRunner
+    {
+    public:
+        explicit SoakRunner(const Options& options) :
+            m_options(options),
+            m_model(nullptr, false)
+        {
+        }
+
+        bool start()
+        {
+            if (!QFileInfo::exists(m_options.slave))
+            {
+                printf("Fake slave not found: %s\n", qPrintable(m_options.slave));
+                return false;
+            }
+
+            // Hérité par les slaves lancés par le superviseur du master
+            qputenv("FAKE_SLAVE_FAULTS", m_options.faults.toLocal8Bit());
+
+            m_model.setScriptName(m_options.slave);
+            m_model.setIntegrityChecks(m_options.integrity);
+            m_model.setCompletionTimeout(m_options.completionTimeoutMs);
+            m_model.setRange(1, m_options.end);
+
+            QObject::connect(&m_model, &AppModel::requestCompleted, &m_model,
+                [this](quint64 id, int errorCode, int, quint64, quint64) { onCompleted(id, errorCode); });
+            QObject::connect(&m_model, &AppModel::requestDropped, &m_model,
+                [this](quint64 id) { onDropped(id); });
+            QObject::connect(&m_model, &AppModel::processInfoChanged, &m_model,
+                [this]() { onProcessInfoChanged(); });
+
+            m_clock.start();
+            m_model.startServices();
+
+            m_segments.resize(IPC_CHANNEL_COUNT);
+            for (int i = 0; i < IPC_CHANNEL_COUNT; ++i)
+                m_segments[i].name = i == 0 ? IPC_NAME : std::string(IPC_NAME) + "_" + std::to_string(i);
+
+            m_lastSuccess = m_clock.elapsed();
+            m_stateSince = m_lastSuccess;
+            m_state = m_model.masterState();
+            m_slavePid = m_model.slavePid();
+
+            QObject::connect(&m_tick, &QTimer::timeout, [this]() { onTick(); });
+            m_tick.start(200);
+
+            QObject::connect(&m_report, &QTimer::timeout, [this]() { report(false); });
+            m_report.start(static_cast<int>(m_options.reportMs));
+
+            QTimer::singleShot(static_cast<int>(m_options.durationMs), [this]()
+            {
+                report(true);
+                QCoreApplication::exit(m_stuckEvents > 0 ? 2 : 0);
+            });
+
+            printf("Soak test: %lld min, faults %s, depth %d, stuck after %lld ms%s\n",
+                m_options.durationMs / 60000, qPrintable(m_options.faults), m_options.depth,
+                m_options.stuckMs, m_options.kill ? "" : " (no kill)");
+            fflush(stdout);
+
+            feed();
+            return true;
+        }
+
+    private:
+        qint64 nowUs() const { return m_clock.nsecsElapsed() / 1000; }
+
+        // Garde la file du master pleine
+        void feed()
+        {
+            while (m_pending.size() < m_options.depth)
+            {
+                const quint64 id = m_model.submit(1, m_options.end);
+                if (id == 0)
+                    break;
+                m_pending.insert(id, nowUs());
+                m_submitted++;
+            }
+        }
+
+        // Début d'un incident : le temps de récupération court jusqu'à la prochaine réponse correcte
+        void markFault(qint64 sinceMs)
+        {
+            if (m_faultSince < 0)
+                m_faultSince = sinceMs;
+        }
+
+        void onCompleted(quint64 id, int errorCode)
+        {
+            const auto it = m_pending.find(id);
+            if (it != m_pending.end())
+            {
+                const qint64 latency = nowUs() - it.value();
+                m_latency.add(latency);
+                m_windowLatency.add(latency);
+                m_pending.erase(it);
+            }
+
+            m_completed++;
+            m_codes[errorCode]++;
+
+            const qint64 now = m_clock.elapsed();
+            if (errorCode == IPCErrorCode::SUCCESS)
+            {
+                if (m_faultSince >= 0)
+                {
+                    m_recovery.add((now - m_faultSince) * 1000);
+                    m_faultSince = -1;
+                }
+                m_lastSuccess = now;
+            }
+            else
+            {
+                markFault(now);
+            }
+
+            feed();
+        }
+
+        void onDropped(quint64 id)
+        {
+            m_pending.remove(id);
+            m_dropped++;
+            feed();
+        }
+
+        void onProcessInfoChanged()
+        {
+            const qint64 now = m_clock.elapsed();
+
+            // Temps passé dans chaque état, et plus long séjour continu
+            const AppModel::MasterState state = m_model.masterState();
+            if (state != m_state)
+            {
+                const qint64 dwell = now - m_stateSince;
+                m_maxDwell[static_cast<int>(m_state)] = qMax(m_maxDwell.value(static_cast<int>(m_state)), dwell);
+                m_state = state;
+                m_stateSince = now;
+            }
+
+            // Slave remplacé : mort, tué, ou bascule sur le standby
+            const int pid = m_model.slavePid();
+            if (pid != m_slavePid)
+            {
+                if (m_slavePid > 0)
+                {
+                    m_slaveChanges++;
+                    markFault(now);
+                }
+                m_slavePid = pid;
+            }
+        }
+
+        void onTick()
+        {
+            const qint64 now = m_clock.elapsed();
+
+            watchSegments(now);
+
+            // Plus aucune réponse correcte alors que des requêtes attendent
+            // Signalé à nouveau toutes les stuckMs tant que ça dure
+            if (m_pending.isEmpty() || now - qMax(m_lastSuccess, m_lastStuck) < m_options.stuckMs)
+                return;
+
+            m_stuckEvents++;
+            m_lastStuck = now;
+            m_stuckStates[static_cast<int>(m_model.masterState())]++;
+            markFault(m_lastSuccess);
+
+            // Lu une fois : après le kill, slavePid() peut déjà désigner le remplaçant
+            const int stuckPid = m_model.slavePid();
+            printf("[%s] STUCK for %lld ms: master %s, slave %s, pid %d, queue %d\n",
+                qPrintable(formatUs(now * 1000)), now - m_lastSuccess,
+                qPrintable(AppModel::masterStateToString(m_model.masterState())),
+                qPrintable(AppModel::slaveStateToString(m_model.slaveState())),
+                stuckPid, m_model.queueDepth());
+
+            if (m_options.kill && killSlave(stuckPid))
+            {
+                m_kills++;
+                printf("  -> killed slave %d\n", stuckPid);
+            }
+            fflush(stdout);
+        }
+
+        void watchSegments(qint64 now)
+        {
+            for (SegmentWatch& watch : m_segments)
+            {
+                if (!watch.mapping.isOpen() && !watch.mapping.open(watch.name, SumChannel::kSize, true))
+                    continue;
+
+                const bool corrupt = !SumChannel(watch.mapping.data()).isValid();
+                if (corrupt && !watch.corrupt)
+                {
+                    m_corruptions++;
+                    watch.corruptSince = now;
+                }
+                else if (!corrupt && watch.corrupt)
+                {
+                    m_repair.add((now - watch.corruptSince) * 1000);
+                }
+                watch.corrupt = corrupt;
+            }
+        }
+
+        static bool killSlave(int pid)
+        {
+#ifdef Q_OS_WIN
+            if (pid <= 0)
+                return false;
+
+            HANDLE process = OpenProcess(PROCESS_TERMINATE, FALSE, static_cast<DWORD>(pid));
+            if (!process)
+                return false;
+
+            const bool killed = TerminateProcess(process, 9) != FALSE;
+            CloseHandle(process);
+            return killed;
+#else
+            Q_UNUSED(pid);
+            return false;
+#endif
+        }
+
+        static const char* codeName(int code)
+        {
+            switch (code)
+            {
+            case IPCErrorCode::SUCCESS:                  return "ok";
+            case IPCErrorCode::START_GREATER_THAN_END:   return "start>end";
+            case IPCErrorCode::OVERFLOW_ERROR:           return "overflow";
+            case IPCErrorCode::FILE_WRITE_ERROR:         return "file";
+            case IPCErrorCode::STOPPED:                  return "stopped";
+            case IPCErrorCode::TIMEOUT_ERROR:            return "timeout";
+            case IPCErrorCode::INTEGRITY_ERROR:          return "integrity";
+            case IPCErrorCode::INVALID_RESPONSE_COUNTER: return "counter";
+            case IPCErrorCode::UNKNOWN_ERROR:            return "unknown";
+            }
+            return "other";
+        }
+
+        void report(bool final)
+        {
+            const qint64 now = m_clock.elapsed();
+            const double windowSeconds = (now - m_windowStart) / 1000.0;
+            const double totalSeconds = now / 1000.0;
+
+            printf("%s[%s] submitted %llu, completed %llu (%.1f req/s, last window %.1f req/s), dropped %llu, pending %lld\n",
+                final ? "\n=== FINAL ===\n" : "",
+                qPrintable(formatUs(now * 1000)),
+                static_cast<unsigned long long>(m_submitted),
+                static_cast<unsigned long long>(m_completed),
+                totalSeconds > 0 ? m_completed / totalSeconds : 0.0,
+                windowSeconds > 0 ? (m_completed - m_windowCompleted) / windowSeconds : 0.0,
+                static_cast<unsigned long long>(m_dropped),
+                static_cast<long long>(m_pending.size()));
+
+            printf("  latency   window %s\n", qPrintable(formatHistogram(m_windowLatency)));
+            printf("  latency   total  %s\n", qPrintable(formatHistogram(m_latency)));
+            printf("  recovery  %llu incident(s)  %s\n",
+                static_cast<unsigned long long>(m_recovery.count()), qPrintable(formatHistogram(m_recovery)));
+
+            printf("  codes    ");
+            for (auto it = m_codes.cbegin(); it != m_codes.cend(); ++it)
+                printf(" %s=%llu", codeName(it.key()), static_cast<unsigned long long>(it.value()));
+            printf("\n");
+
+            printf("  slaves    %llu change(s), %llu kill(s)   segments %llu corruption(s), repaired %s\n",
+                static_cast<unsigned long long>(m_slaveChanges),
+                static_cast<unsigned long long>(m_kills),
+                static_cast<unsigned long long>(m_corruptions),
+                qPrintable(formatHistogram(m_repair)));
+
+            printf("  stuck     %llu", static_cast<unsigned long long>(m_stuckEvents));
+            for (auto it = m_stuckStates.cbegin(); it != m_stuckStates.cend(); ++it)
+                printf(" %s=%llu", qPrintable(AppModel::masterStateToString(static_cast<AppModel::MasterState>(it.key()))),
+                    static_cast<unsigned long long>(it.value()));
+            printf("\n");
+
+            // Séjour le plus long dans chaque état, état courant compris
+            QMap<int, qint64> dwell = m_maxDwell;
+            dwell[static_cast<int>(m_state)] = qMax(dwell.value(static_cast<int>(m_state)), now - m_stateSince);
+            printf("  max dwell");
+            for (auto it = dwell.cbegin(); it != dwell.cend(); ++it)
+                printf(" %s=%s", qPrintable(AppModel::masterStateToString(static_cast<AppModel::MasterState>(it.key()))),
+                    qPrintable(formatUs(it.value() * 1000)));
+            printf("\n");
+
+            fflush(stdout);
+
+            m_windowStart = now;
+            m_windowCompleted = m_completed;
+            m_windowLatency.clear();
+        }
+
+    private:
+        Options m_options;
+        AppModel m_model;
+        QElapsedTimer m_clock;
+        QTimer m_tick;
+        QTimer m_report;
+
+        QHash<quint64, qint64> m_pending;   // id -> instant de soumission (us)
+        quint64 m_submitted = 0;
+        quint64 m_completed = 0;
+        quint64 m_dropped = 0;
+        QMap<int, quint64> m_codes;
+
+        Histogram m_latency;
+        Histogram m_windowLatency;
+        Histogram m_recovery;
+        Histogram m_repair;
+        qint64 m_windowStart = 0;
+        quint64 m_windowCompleted = 0;
+
+        qint64 m_faultSince = -1;
+        qint64 m_lastSuccess = 0;
+        qint64 m_lastStuck = 0;
+        quint64 m_stuckEvents = 0;
+        quint64 m_kills = 0;
+        QMap<int, quint64> m_stuckStates;
+
+        AppModel::MasterState m_state = AppModel::MasterState::Idle;
+        qint64 m_stateSince = 0;
+        QMap<int, qint64> m_maxDwell;
+
+        int m_slavePid = -1;
+        quint64 m_slaveChanges = 0;
+
+        std::vector<SegmentWatch> m_segments;
+        quint64 m_corruptions = 0;
+    };
+
+    // Le worker trace chaque requête en qDebug : illisible sur des heures
+    bool g_verbose = false;
+
+    void messageHandler(QtMsgType type, const QMessageLogContext&, const QString& message)
+    {
+        if (type == QtDebugMsg && !g_verbose)
+            return;
+        fprintf(stderr, "%s\n", qPrintable(message));
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Soak test of the master against fault-injecting slaves");
+    parser.addHelpOption();
+    parser.addOptions({
+        { "minutes", "Test duration.", "N", "60" },
+        { "faults", "Fault spec passed to FakeSlave (see Tests/FakeSlave/main.cpp).", "SPEC" },
+        { "slave", "Fake slave executable.", "PATH" },
+        { "depth", "Requests kept queued in the master.", "N", "4" },
+        { "end", "Requests sum 1..N.", "N", "1000" },
+        { "stuck-ms", "No correct response for this long with requests pending = stuck.", "MS", "45000" },
+        { "completion-timeout-ms", "Master's completion timeout for a silent slave (0 = none).", "MS", "20000" },
+        { "report-s", "Report interval.", "S", "60" },
+        { "no-kill", "Report stuck states without killing the active slave." },
+        { "no-integrity", "Disable CRC32C checks." },
+        { "verbose", "Keep the master's debug output." },
+    });
+    parser.process(app);
+
+    Options options;
+    options.durationMs = parser.value("minutes").toLongLong() * 60 * 1000;
+    if (parser.isSet("faults"))
+        options.faults = parser.value("faults");
+    options.slave = parser.isSet("slave") ? parser.value("slave")
+        : QDir(QCoreApplication::applicationDirPath()).filePath("FakeSlave.exe");
+    options.slave = QFileInfo(options.slave).absoluteFilePath();
+    options.depth = qMax(1, parser.value("depth").toInt());
+    options.end = parser.value("end").toInt();
+    options.stuckMs = parser.value("stuck-ms").toLongLong();
+    options.completionTimeoutMs = parser.value("completion-timeout-ms").toInt();
+    options.reportMs = qMax(1LL, parser.value("report-s").toLongLong()) * 1000;
+    options.kill = !parser.isSet("no-kill");
+    options.integrity = !parser.isSet("no-integrity");
+    options.verbose = parser.isSet("verbose");
+
+    if (options.durationMs <= 0 || options.stuckMs <= 0)
+        parser.showHelp(1);
+
+    g_verbose = options.verbose;
+    qInstallMessageHandler(messageHandler);
+
+    SoakRunner runner(options);
+    if (!runner.start())
+        return 1;
+
+    return app.exec();
+}
@@ -0,0 +1,504 @@
+// Comparaison des deux transports du master : mémoire partagée et socket Unix
+// Même AppModel, même NativeSlave, mêmes charges, rejouées pour chaque transport :
+//   burst   --requests requêtes enchaînées, --depth maintenues dans la file (débit)
+//   paced   --paced requêtes, une toutes les --pace-ms (latence hors saturation)
+//   idle    --idle-s secondes sans requête (coût d'un slave au repos)
+// Mesures : débit, latence bout en bout p50/p99/max, CPU du master et du slave actif
+// (GetProcessTimes), CPU par requête.
+//
+// Le slave est lancé par le superviseur du master sans argument, donc en --transport auto :
+// il suit le transport de chaque requête. Les slaves de secours ne reçoivent rien et ne
+// sont pas mesurés.
+//
+// Exemple : TransportBench.exe --requests 5000 --paced 500 --pace-ms 5
+
+#include "AppModel.h"
+#include "SharedData.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QHash>
+#include <QSet>
+#include <QTemporaryDir>
+#include <QTimer>
+#include <QVector>
+
+#include <algorithm>
+
+#include <stdio.h>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#endif
+
+namespace
+{
+    struct Options
+    {
+        QString slave;
+        int requests = 2000;
+        int paced = 200;
+        int paceMs = 10;
+        int depth = 4;
+        int end = 1000;
+        int warmup = 20;
+        qint64 idleMs = 3000;
+        qint64 warmupTimeoutMs = 10000;     // le slave retente la connexion au socket toutes les secondes
+        bool integrity = true;
+        bool verbose = false;
+    };
+
+    enum class Workload
+    {
+        Warmup,
+        Burst,
+        Paced,
+        Idle
+    };
+
+    const char* workloadName(Workload workload)
+    {
+        switch (workload)
+        {
+        case Workload::Warmup: return "warmup";
+        case Workload::Burst:  return "burst";
+        case Workload::Paced:  return "paced";
+        case Workload::Idle:   return "idle";
+        }
+        return "?";
+    }
+
+    struct Step
+    {
+        AppModel::Transport transport;
+        Workload workload;
+    };
+
+    struct StepResult
+    {
+        Step step;
+        bool available = true;
+        int completed = 0;
+        int errors = 0;
+        int wrongTransport = 0;     // servies par l'autre transport (repli du master)
+        qint64 wallUs = 0;
+        qint64 masterCpuUs = -1;
+        qint64 slaveCpuUs = -1;     // -1 : slave remplacé pendant la mesure, ou plateforme sans mesure
+        QVector<qint64> latencies;
+    };
+
+    // Temps CPU (noyau + utilisateur) d'un process, pid <= 0 : le process courant
+    qint64 processCpuUs(qint64 pid)
+    {
+#ifdef Q_OS_WIN
+        HANDLE process = pid > 0 ? OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, static_cast<DWORD>(pid)) : GetCurrentProcess();
+        if (!process)
+            return -1;
+
+        FILETIME creation, exit, kernel, user;
+        const bool ok = GetProcessTimes(process, &creation, &exit, &kernel, &user) != FALSE;
+        if (pid > 0)
+            CloseHandle(process);
+        if (!ok)
+            return -1;
+
+        // Unités de 100 ns
+        auto toUs = [](const FILETIME& time)
+        {
+            return static_cast<qint64>((static_cast<quint64>(time.dwHighDateTime) << 32) | time.dwLowDateTime) / 10;
+        };
+        return toUs(kernel) + toUs(user);
+#else
+        Q_UNUSED(pid);
+        return -1;
+#endif
+    }
+
+    QString formatUs(qint64 us)
+    {
+        if (us < 0)
+            return "-";
+        if (us >= 1000000)
+            return QString::number(us / 1e6, 'f', 2) + " s";
+        if (us >= 1000)
+            return QString::number(us / 1e3, 'f', 2) + " ms";
+        return QString::number(us) + " us";
+    }
+
+    QString formatPercent(qint64 cpuUs, qint64 wallUs)
+    {
+        if (cpuUs < 0 || wallUs <= 0)
+            return "-";
+        return QString::number(100.0 * cpuUs / wallUs, 'f', 1) + " %";
+    }
+
+    // Latences triées
+    qint64 percentile(const QVector<qint64>& sorted, double q)
+    {
+        if (sorted.isEmpty())
+            return -1;
+        const int rank = qBound(0, static_cast<int>(q * sorted.size() + 0.5) - 1, sorted.size() - 1);
+        return sorted[rank];
+    }
+
+    class TransportBench
+    {
+    public:
+        explicit TransportBench(const Options& options) :
+            m_options(options),
+            m_model(nullptr, false)
+        {
+            for (AppModel::Transport transport : { AppModel::Transport::SharedMemory, AppModel::Transport::UnixSocket })
+            {
+                for (Workload workload : { Workload::Warmup, Workload::Burst, Workload::Paced, Workload::Idle })
+                    m_steps.append({ transport, workload });
+            }
+        }
+
+        bool start()
+        {
+            if (!QFileInfo::exists(m_options.slave))
+            {
+                printf("Native slave not found: %s\n", qPrintable(m_options.slave));
+                return false;
+            }
+            if (!m_folder.isValid())
+            {
+                printf("Cannot create a temporary result folder\n");
+                return false;
+            }
+
+            m_model.setScriptName(m_options.slave);
+            m_model.setFolder(m_folder.path());
+            m_model.setIntegrityChecks(m_options.integrity);
+            m_model.setRange(1, m_options.end);
+
+            QObject::connect(&m_model, &AppModel::requestCompleted, &m_model,
+                [this](quint64 id, int errorCode, int, quint64, quint64) { onCompleted(id, errorCode == IPCErrorCode::SUCCESS, true); });
+            QObject::connect(&m_model, &AppModel::requestDropped, &m_model,
+                [this](quint64 id) { onCompleted(id, false, false); });
+
+            QObject::connect(&m_pace, &QTimer::timeout, [this]() { onPace(); });
+
+            m_clock.start();
+            m_model.startServices();
+
+            printf("Transport bench: slave %s\n", qPrintable(m_options.slave));
+            printf("  burst %d request(s), depth %d | paced %d request(s) every %d ms | idle %lld s | sum 1..%d, CRC32C %s\n\n",
+                m_options.requests, m_options.depth, m_options.paced, m_options.paceMs,
+                m_options.idleMs / 1000, m_options.end, m_options.integrity ? "on" : "off");
+            fflush(stdout);
+
+            beginStep();
+            return true;
+        }
+
+    private:
+        qint64 nowUs() const { return m_clock.nsecsElapsed() / 1000; }
+
+        const Step& step() const { return m_steps[m_stepIndex]; }
+
+        void beginStep()
+        {
+            // Transport indisponible : ses autres charges sont sautées
+            while (m_stepIndex < m_steps.size() && m_unavailable.contains(static_cast<int>(step().transport)))
+            {
+                StepResult skipped;
+                skipped.step = step();
+                skipped.available = false;
+                if (skipped.step.workload != Workload::Warmup)
+                    m_results.append(skipped);
+                m_stepIndex++;
+            }
+
+            if (m_stepIndex >= m_steps.size())
+            {
+                printTable();
+                QCoreApplication::exit(0);
+                return;
+            }
+
+            m_model.setTransport(step().transport);
+
+            m_current = StepResult();
+            m_current.step = step();
+            m_submitted = 0;
+            m_pending.clear();
+
+            printf("%-13s %-6s ...\n", qPrintable(AppModel::transportToString(step().transport)), workloadName(step().workload));
+            fflush(stdout);
+
+            m_stepStart = nowUs();
+            m_slavePid = m_model.slavePid();
+            m_masterCpuStart = processCpuUs(0);
+            m_slaveCpuStart = processCpuUs(m_slavePid);
+
+            switch (step().workload)
+            {
+            case Workload::Warmup:
+            case Workload::Burst:
+                feed();
+                break;
+            case Workload::Paced:
+                m_pace.start(m_options.paceMs);
+                onPace();
+                break;
+            case Workload::Idle:
+                QTimer::singleShot(static_cast<int>(m_options.idleMs), [this]() { endStep(); });
+                break;
+            }
+        }
+
+        void endStep()
+        {
+            m_pace.stop();
+
+            const qint64 masterCpu = processCpuUs(0);
+            const qint64 slaveCpu = processCpuUs(m_slavePid);
+
+            m_current.wallUs = nowUs() - m_stepStart;
+            if (m_masterCpuStart >= 0 && masterCpu >= 0)
+                m_current.masterCpuUs = masterCpu - m_masterCpuStart;
+            if (m_slaveCpuStart >= 0 && slaveCpu >= 0 && m_model.slavePid() == m_slavePid)
+                m_current.slaveCpuUs = slaveCpu - m_slaveCpuStart;
+            std::sort(m_current.latencies.begin(), m_current.latencies.end());
+
+            if (step().workload != Workload::Warmup)
+                m_results.append(m_current);
+
+            m_stepIndex++;
+            beginStep();
+        }
+
+        int target() const
+        {
+            switch (step().workload)
+            {
+            case Workload::Warmup: return m_options.warmup;
+            case Workload::Burst:  return m_options.requests;
+            case Workload::Paced:  return m_options.paced;
+            case Workload::Idle:   return 0;
+            }
+            return 0;
+        }
+
+        bool submit()
+        {
+            const quint64 id = m_model.submit(1, m_options.end);
+            if (id == 0)
+                return false;
+            m_pending.insert(id, nowUs());
+            m_submitted++;
+            return true;
+        }
+
+        // Warmup : autant de requêtes qu'il en faut jusqu'au délai, seules les réussies comptent
+        bool wantsMore() const
+        {
+            if (step().workload == Workload::Warmup)
+                return m_warmupServed + m_pending.size() < m_options.warmup;
+            return m_submitted < target();
+        }
+
+        // Burst et warmup : garde la file du master pleine
+        void feed()
+        {
+            while (m_pending.size() < m_options.depth && wantsMore())
+            {
+                if (!submit())
+                    break;
+            }
+        }
+
+        // Paced : en boucle ouverte, une requête en retard n'en retarde pas d'autres
+        void onPace()
+        {
+            if (m_submitted < target())
+                submit();
+            else
+                m_pace.stop();
+        }
+
+        // served : requête passée par un transport (false si retirée de la file)
+        void onCompleted(quint64 id, bool success, bool served)
+        {
+            const auto it = m_pending.find(id);
+            if (it == m_pending.end())
+                return;
+
+            m_current.latencies.append(nowUs() - it.value());
+            m_pending.erase(it);
+            m_current.completed++;
+            if (!success)
+                m_current.errors++;
+
+            // Le transport de la requête reste consultable jusqu'au lancement de la suivante
+            const bool rightTransport = served && m_model.inFlightTransport() == step().transport;
+            if (served && !rightTransport)
+                m_current.wrongTransport++;
+
+            if (step().workload == Workload::Warmup)
+            {
+                onWarmupCompleted(rightTransport && success);
+                return;
+            }
+
+            if (step().workload == Workload::Burst)
+                feed();
+
+            if (m_current.completed >= target())
+                endStep();
+        }
+
+        // Le warmup se termine après --warmup requêtes servies par le bon transport :
+        // le slave a eu le temps de se connecter au socket
+        void onWarmupCompleted(bool servedRight)
+        {
+            if (servedRight)
+                m_warmupServed++;
+
+            if (m_warmupServed >= m_options.warmup)
+            {
+                m_warmupServed = 0;
+                endStep();
+                return;
+            }
+
+            if (nowUs() - m_stepStart > m_options.warmupTimeoutMs * 1000)
+            {
+                printf("  %s unavailable: no request served by it within %lld ms\n",
+                    qPrintable(AppModel::transportToString(step().transport)), m_options.warmupTimeoutMs);
+                m_unavailable.insert(static_cast<int>(step().transport));
+                m_warmupServed = 0;
+                endStep();
+                return;
+            }
+
+            feed();
+        }
+
+        void printTable() const
+        {
+            printf("\n%-13s %-6s %6s %6s %10s %10s %10s %10s %10s %10s %10s\n",
+                "transport", "load", "reqs", "errors", "req/s", "p50", "p99", "max", "master CPU", "slave CPU", "CPU/req");
+
+            // Groupé par charge : les deux transports l'un sous l'autre
+            for (Workload workload : { Workload::Burst, Workload::Paced, Workload::Idle })
+            {
+                for (const StepResult& result : m_results)
+                {
+                    if (result.step.workload != workload)
+                        continue;
+
+                    const QString transport = AppModel::transportToString(result.step.transport);
+                    if (!result.available)
+                    {
+                        printf("%-13s %-6s unavailable\n", qPrintable(transport), workloadName(workload));
+                        continue;
+                    }
+
+                    const double seconds = result.wallUs / 1e6;
+                    const qint64 cpuPerRequest = result.completed > 0 && result.masterCpuUs >= 0 && result.slaveCpuUs >= 0
+                        ? (result.masterCpuUs + result.slaveCpuUs) / result.completed : -1;
+
+                    printf("%-13s %-6s %6d %6d %10s %10s %10s %10s %10s %10s %10s\n",
+                        qPrintable(transport), workloadName(workload),
+                        result.completed, result.errors,
+                        result.completed > 0 && seconds > 0 ? qPrintable(QString::number(result.completed / seconds, 'f', 1)) : "-",
+                        qPrintable(formatUs(percentile(result.latencies, 0.50))),
+                        qPrintable(formatUs(percentile(result.latencies, 0.99))),
+                        qPrintable(formatUs(result.latencies.isEmpty() ? -1 : result.latencies.last())),
+                        qPrintable(formatPercent(result.masterCpuUs, result.wallUs)),
+                        qPrintable(formatPercent(result.slaveCpuUs, result.wallUs)),
+                        qPrintable(formatUs(cpuPerRequest)));
+
+                    if (result.wrongTransport > 0)
+                        printf("  ! %d request(s) served by the other transport\n", result.wrongTransport);
+                }
+            }
+            printf("\nCPU in %% of one core over the workload's wall time; CPU/req = (master + slave) / reqs\n");
+            fflush(stdout);
+        }
+
+    private:
+        Options m_options;
+        QTemporaryDir m_folder;
+        AppModel m_model;
+        QElapsedTimer m_clock;
+        QTimer m_pace;
+
+        QVector<Step> m_steps;
+        int m_stepIndex = 0;
+        QSet<int> m_unavailable;
+        QVector<StepResult> m_results;
+
+        StepResult m_current;
+        QHash<quint64, qint64> m_pending;   // id -> instant de soumission (us)
+        int m_submitted = 0;
+        int m_warmupServed = 0;
+        qint64 m_stepStart = 0;
+        int m_slavePid = -1;
+        qint64 m_masterCpuStart = -1;
+        qint64 m_slaveCpuStart = -1;
+    };
+
+    bool g_verbose = false;
+
+    void messageHandler(QtMsgType type, const QMessageLogContext&, const QString& message)
+    {
+        if (type == QtDebugMsg && !g_verbose)
+            return;
+        fprintf(stderr, "%s\n", qPrintable(message));
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Side-by-side latency and CPU comparison of the shared-memory and Unix-socket transports");
+    parser.addHelpOption();
+    parser.addOptions({
+        { "slave", "Native slave executable.", "PATH" },
+        { "requests", "Requests in the burst workload.", "N", "2000" },
+        { "depth", "Requests kept queued in the master during the burst.", "N", "4" },
+        { "paced", "Requests in the paced workload.", "N", "200" },
+        { "pace-ms", "Interval between paced requests.", "MS", "10" },
+        { "idle-s", "Duration of the idle workload.", "S", "3" },
+        { "warmup", "Requests served by a transport before measuring it.", "N", "20" },
+        { "end", "Requests sum 1..N.", "N", "1000" },
+        { "no-integrity", "Disable CRC32C checks." },
+        { "verbose", "Keep the master's debug output." },
+    });
+    parser.process(app);
+
+    Options options;
+    options.slave = parser.isSet("slave") ? parser.value("slave")
+        : QDir(QCoreApplication::applicationDirPath()).filePath("NativeSlave.exe");
+    options.slave = QFileInfo(options.slave).absoluteFilePath();
+    options.requests = parser.value("requests").toInt();
+    options.depth = qMax(1, parser.value("depth").toInt());
+    options.paced = parser.value("paced").toInt();
+    options.paceMs = qMax(1, parser.value("pace-ms").toInt());
+    options.idleMs = parser.value("idle-s").toLongLong() * 1000;
+    options.warmup = qMax(1, parser.value("warmup").toInt());
+    options.end = parser.value("end").toInt();
+    options.integrity = !parser.isSet("no-integrity");
+    options.verbose = parser.isSet("verbose");
+
+    if (options.requests <= 0 || options.paced <= 0 || options.idleMs <= 0)
+        parser.showHelp(1);
+
+    g_verbose = options.verbose;
+    qInstallMessageHandler(messageHandler);
+
+    TransportBench bench(options);
+    if (!bench.start())
+        return 1;
+
+    return app.exec();
+}
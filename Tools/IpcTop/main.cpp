@@ -0,0 +1,246 @@
+// ipc_top : suivi en direct des statistiques d'un master et de ses slaves
+// S'attache en lecture seule aux régions "<canal>_stats" : aucun effet sur
+// le master observé, ni sur son thread UI
+
+#include "IpcStats.h"
+#include "SharedMemoryMapping.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#ifndef IPC_NAME
+#define IPC_NAME "ipc_masterslave_shm"
+#endif
+
+namespace
+{
+    struct Options
+    {
+        std::vector<std::string> channels;
+        int intervalMs = 1000;
+        bool once = false;      // un seul relevé (totaux), pour les scripts
+    };
+
+    // Un canal observé : région mappée et relevé précédent pour les débits
+    struct Channel
+    {
+        std::string name;
+        SharedMemoryMapping mapping;
+        bool hasPrevious = false;
+        IpcStatsBlock previous[2] = {};
+    };
+
+    std::atomic<bool> g_stop{ false };
+
+    void onSignal(int)
+    {
+        g_stop = true;
+    }
+
+    void printUsage(const char* exe)
+    {
+        printf("Usage: %s [--shm NAME]... [--interval-ms N] [--once]\n", exe);
+        printf("Default channels: %s %s_1\n", IPC_NAME, IPC_NAME);
+    }
+
+    bool parseOptions(int argc, char* argv[], Options& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const char* arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+
+            if (strcmp(arg, "--shm") == 0 && hasValue)
+                options.channels.push_back(argv[++i]);
+            else if (strcmp(arg, "--interval-ms") == 0 && hasValue)
+                options.intervalMs = atoi(argv[++i]);
+            else if (strcmp(arg, "--once") == 0)
+                options.once = true;
+            else
+                return false;
+        }
+
+        if (options.channels.empty())
+        {
+            options.channels.push_back(IPC_NAME);
+            options.channels.push_back(std::string(IPC_NAME) + "_1");
+        }
+
+        return options.intervalMs > 0;
+    }
+
+    const char* errorName(uint32_t slot)
+    {
+        switch (slot < IpcStatsErrors::COUNT ? IpcStatsErrors::CODES[slot] : -1)
+        {
+        case IPCErrorCode::SUCCESS:                  return "ok";
+        case IPCErrorCode::START_GREATER_THAN_END:   return "start>end";
+        case IPCErrorCode::OVERFLOW_ERROR:           return "overflow";
+        case IPCErrorCode::FILE_WRITE_ERROR:         return "file";
+        case IPCErrorCode::STOPPED:                  return "stopped";
+        case IPCErrorCode::TIMEOUT_ERROR:            return "timeout";
+        case IPCErrorCode::INTEGRITY_ERROR:          return "integrity";
+        case IPCErrorCode::INVALID_RESPONSE_COUNTER: return "counter";
+        case IPCErrorCode::UNKNOWN_ERROR:            return "unknown";
+        }
+        return "other";
+    }
+
+    // Octets par seconde lisibles
+    std::string formatRate(double bytesPerSecond)
+    {
+        char text[32];
+        if (bytesPerSecond >= 1024.0 * 1024.0)
+            snprintf(text, sizeof(text), "%.1f MiB/s", bytesPerSecond / (1024.0 * 1024.0));
+        else if (bytesPerSecond >= 1024.0)
+            snprintf(text, sizeof(text), "%.1f KiB/s", bytesPerSecond / 1024.0);
+        else
+            snprintf(text, sizeof(text), "%.0f B/s", bytesPerSecond);
+        return text;
+    }
+
+    void printBlock(const char* role, const IpcStatsBlock& now, const IpcStatsBlock* before, double seconds)
+    {
+        if (now.pid == 0)
+        {
+            printf("  %-6s (no writer)\n", role);
+            return;
+        }
+
+        const uint64_t nowMs = IpcStats::wallClockMs();
+        const double ageSeconds = now.heartbeatMs && nowMs > now.heartbeatMs ? (nowMs - now.heartbeatMs) / 1000.0 : 0.0;
+
+        uint64_t errors = 0;
+        for (uint32_t slot = 1; slot < IpcStatsErrors::SLOTS; ++slot)
+            errors += now.errors[slot];
+
+        printf("  %-6s pid %-6llu  seen %.1fs ago  req %llu  resp %llu  errors %llu  mismatches %llu  timeouts %llu\n",
+            role,
+            static_cast<unsigned long long>(now.pid),
+            ageSeconds,
+            static_cast<unsigned long long>(now.requests),
+            static_cast<unsigned long long>(now.responses),
+            static_cast<unsigned long long>(errors),
+            static_cast<unsigned long long>(now.counterMismatches),
+            static_cast<unsigned long long>(now.timeouts));
+
+        // Un écrivain relancé repart de zéro : pas de débit sur ce relevé
+        if (before && seconds > 0 && before->pid == now.pid && now.requests >= before->requests)
+        {
+            const double busy = static_cast<double>(now.busyNs - before->busyNs);
+            const double idle = static_cast<double>(now.idleNs - before->idleNs);
+            const double busyPercent = busy + idle > 0 ? 100.0 * busy / (busy + idle) : 0.0;
+
+            printf("         %.1f req/s  %.1f resp/s  in %s  out %s  busy %.0f%%\n",
+                (now.requests - before->requests) / seconds,
+                (now.responses - before->responses) / seconds,
+                formatRate((now.bytesIn - before->bytesIn) / seconds).c_str(),
+                formatRate((now.bytesOut - before->bytesOut) / seconds).c_str(),
+                busyPercent);
+        }
+
+        // Détail des codes non nuls
+        printf("         codes:");
+        for (uint32_t slot = 0; slot < IpcStatsErrors::SLOTS; ++slot)
+        {
+            if (now.errors[slot] != 0)
+                printf(" %s=%llu", errorName(slot), static_cast<unsigned long long>(now.errors[slot]));
+        }
+        printf("\n");
+    }
+
+    void enableAnsi()
+    {
+#ifdef _WIN32
+        HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
+        DWORD mode = 0;
+        if (GetConsoleMode(console, &mode))
+            SetConsoleMode(console, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+#endif
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    if (!options.once)
+        enableAnsi();
+
+    std::vector<Channel> channels(options.channels.size());
+    for (size_t i = 0; i < channels.size(); ++i)
+        channels[i].name = options.channels[i];
+
+    auto previousTime = std::chrono::steady_clock::now();
+
+    while (!g_stop)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        const double seconds = std::chrono::duration<double>(now - previousTime).count();
+        previousTime = now;
+
+        if (!options.once)
+            printf("\x1b[2J\x1b[H");
+        printf("ipc_top - %zu channel(s), refresh %d ms (Ctrl+C to quit)\n\n", channels.size(), options.intervalMs);
+
+        for (Channel& channel : channels)
+        {
+            const std::string regionName = IpcStats::regionName(channel.name);
+
+            // Le master peut ne pas encore exister ou avoir été relancé
+            if (!channel.mapping.isOpen())
+            {
+                channel.hasPrevious = false;
+                channel.mapping.open(regionName, sizeof(IpcStatsRegion), true);
+            }
+
+            const IpcStatsRegion* region = static_cast<const IpcStatsRegion*>(channel.mapping.data());
+            if (!IpcStats::isValid(region))
+            {
+                printf("%s: not available\n\n", regionName.c_str());
+                channel.mapping.close();
+                continue;
+            }
+
+            const IpcStatsBlock blocks[2] = { IpcStats::snapshot(&region->master), IpcStats::snapshot(&region->slave) };
+
+            printf("%s\n", channel.name.c_str());
+            printBlock("master", blocks[0], channel.hasPrevious ? &channel.previous[0] : nullptr, seconds);
+            printBlock("slave", blocks[1], channel.hasPrevious ? &channel.previous[1] : nullptr, seconds);
+            printf("\n");
+
+            channel.previous[0] = blocks[0];
+            channel.previous[1] = blocks[1];
+            channel.hasPrevious = true;
+        }
+
+        fflush(stdout);
+
+        if (options.once)
+            break;
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(options.intervalMs));
+    }
+
+    return 0;
+}